@@ -97,6 +97,11 @@ public:
      * @param t Time of the output.
      */
     virtual void output(double t) = 0;
+
+    /**
+     * @brief      Closes any output file the detector keeps open so another detector can append to it
+     */
+    virtual void closeOutput() {}
 };
 
 class parallelDetectorBaseReal : public parallelDetectorBase<double>
@@ -152,4 +157,29 @@ public:
     virtual void output(double t) = 0;
 };
 
+class parallelDetectorBaseFloat : public parallelDetectorBase<float>
+{
+public:
+    /**
+     * @brief      Constructs a base detector
+     *
+     * @param[in]  grids         The fields that need to be output
+     * @param[in]  SI            True if using SI units
+     * @param[in]  loc           The location in grid point position
+     * @param[in]  sz            The size in number of grid points
+     * @param[in]  type          The type: output type of dtc: fields or power
+     * @param[in]  timeInterval  The time interval
+     * @param[in]  a             unit length
+     * @param[in]  I0            unit current
+     * @param[in]  dt            time step
+     */
+    parallelDetectorBaseFloat(std::vector<float_pgrid_ptr> grids, bool SI, std::array<int,3> loc, std::array<int,3> sz, DTCTYPE type, double timeInterval, double a, double I0, double dt);
+    /**
+     * @brief      outputs the data to the field
+     *
+     * @param[in]  t     current simulation time
+     */
+    virtual void output(double t) = 0;
+};
+
 #endif
@@ -31,8 +31,9 @@ public:
      * @param[in]  a             unit length
      * @param[in]  I0            unit current
      * @param[in]  dt            time step
+     * @param[in]  append        If true append to the output file instead of starting a new one (used when a run is continued by a rebuilt propagator)
      */
-    parallelDetectorBINReal(std::vector<real_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt) ;
+    parallelDetectorBINReal(std::vector<real_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt, bool append=false);
     /**
      * @brief Outputs to a binary file
      *
@@ -73,8 +74,9 @@ public:
      * @param[in]  a             unit length
      * @param[in]  I0            unit current
      * @param[in]  dt            time step
+     * @param[in]  append        If true append to the output file instead of starting a new one (used when a run is continued by a rebuilt propagator)
      */
-    parallelDetectorBINCplx(std::vector<cplx_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt) ;
+    parallelDetectorBINCplx(std::vector<cplx_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt, bool append=false);
 
    /**
      * @brief Outputs to a binary file
@@ -89,4 +91,48 @@ public:
     inline std::string outfile() {return outFile_;}
 };
 
+class parallelDetectorBINFloat : public parallelDetectorBaseFloat
+{
+protected:
+    using parallelDetectorBaseFloat::timeInterval_; //!< The stride of the time (How often should the detector print?)
+    using parallelDetectorBaseFloat::tConv_; //!< conversion factor for t to get it in the correct units
+    using parallelDetectorBaseFloat::convFactor_; //!< Conversion factor for the type of output (to SI units from FDTD)
+    using parallelDetectorBaseFloat::sz_; //!< the location of the detector's lower left corner
+    using parallelDetectorBaseFloat::loc_; //!< the size in grid points of the detector
+    using parallelDetectorBaseFloat::realSpaceLoc_; //!< Location of lower, left, back corner in real spaceZ
+    using parallelDetectorBaseFloat::fields_; //!< A vector of shared pointers to each of the grids associated with the detector
+    using parallelDetectorBaseFloat::outputFunction_; //!< function to take grids and output to file in the correct manner
+
+    std::string outFile_; //!< output file name
+    std::vector<float> gridVals_; //!< temporary storage of grid values before transfer into a file
+    std::vector<double> fileVals_; //!< grid values converted to double so the file format is the same as for double precision fields
+public:
+    /**
+     * @brief      Constructs a detector that outputs to a binary file
+     *
+     * @param[in]  grid          a vector of pointers to output grids
+     * @param[in]  SI            True if using SI units
+     * @param[in]  loc           The location in grid points
+     * @param[in]  sz            The size in grid points
+     * @param[in]  out_name      The output file name
+     * @param[in]  type          The type: output type of dtc: fields or power
+     * @param[in]  timeInterval  The time interval
+     * @param[in]  a             unit length
+     * @param[in]  I0            unit current
+     * @param[in]  dt            time step
+     * @param[in]  append        If true append to the output file instead of starting a new one (used when a run is continued by a rebuilt propagator)
+     */
+    parallelDetectorBINFloat(std::vector<float_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt, bool append=false);
+    /**
+     * @brief Outputs to a binary file
+     *
+     * @param[in] t time of the simulation
+     */
+    void output(double t);
+    /**
+     * @brief returns the output file name
+     */
+    inline std::string outfile() {return outFile_;}
+};
+
 #endif
@@ -74,4 +74,41 @@ public:
      */
     void output(double t);
 };
+
+class parallelDetectorCOUTFloat: public parallelDetectorBaseFloat
+{
+protected:
+    using parallelDetectorBaseFloat::timeInterval_; //!< The stride of the time (How often should the detector print?)
+    using parallelDetectorBaseFloat::tConv_; //!< conversion factor for t to get it in the correct units
+    using parallelDetectorBaseFloat::convFactor_; //!< Conversion factor for the type of output (to SI units from FDTD)
+    using parallelDetectorBaseFloat::sz_; //!< the location of the detector's lower left corner
+    using parallelDetectorBaseFloat::loc_; //!< the size in grid points of the detector
+    using parallelDetectorBaseFloat::realSpaceLoc_; //!< Location of lower, left, back corner in real spaceZ
+    using parallelDetectorBaseFloat::fields_; //!< A vector of shared pointers to each of the grids associated with the detector
+    using parallelDetectorBaseFloat::outputFunction_; //!< function to take grids and output to file in the correct manner
+
+public:
+    /**
+     * @brief      Constructs a detector that outputs to console
+     *
+     * @param[in]  grid          a vector of pointers to output grids
+     * @param[in]  SI            bool to determine if SI units are used
+     * @param[in]  loc           location of lower left corner of the dtc
+     * @param[in]  sz            size in grid points for the dtc
+     * @param[in]  out_name      output file name
+     * @param[in]  type          The type: output type of dtc: fields or power
+     * @param[in]  timeInterval  Time interval for how often to record data
+     * @param[in]  a             unit length
+     * @param[in]  I0            unit current
+     * @param[in]  dt            time step
+     */
+    parallelDetectorCOUTFloat(std::vector<float_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt);
+    /**
+     * @brief Outputs the information to console
+     *
+     * @param[in] t Time of the output.
+     */
+    void output(double t);
+};
+
 #endif
\ No newline at end of file
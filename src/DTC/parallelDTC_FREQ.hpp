@@ -11,9 +11,9 @@ public:
 
     struct masterImportDat
     {
-        int addIndex_; //!< index of the first point on the surface
+        std::vector<int> addIndex_; //!< offset of the process' part of the detector from the detector's lower, left, back corner
         int slaveProc_; //!< rank of the slave process this describes
-        int sz_; //!< total size of the spatial coordinates of the detector
+        std::vector<int> sz_; //!< size of the process' part of the detector in each direction
         template <typename Archive>
         void serialize(Archive& ar, const unsigned int version)
         {
@@ -33,7 +33,8 @@ protected:
     int t_step_; //!< current time step
     int timeInt_; //!< Time interval
     int nfreq_; //!< number of frequencies
-    int addIndex_; //!< index of the first point on the surface
+    std::vector<int> addIndex_; //!< offset of the master process' part of the detector from the detector's lower, left, back corner
+    std::vector<int> procSz_; //!< size of the master process' part of the detector in each direction
 
     double dt_; //!< time step
     double freqConv_; //!< conversion factor for the frequency
@@ -55,6 +56,7 @@ protected:
     std::string fname_; //!< output file name
 
     std::vector<cplx_grid_ptr> freqFields_; //!< fields being used in detector
+    std::vector<cplx_grid_ptr> carryFields_; //!< Fourier transformed fields collected before the detector was rebuilt by a load rebalance (only on the master process)
     std::vector<double> freqList_; //!< list of all frequencies
 
     std::function<cplx(int, cplx*, int, cplx*, int, double)> toOutFile_; //!< function to output correct values to the output file
@@ -135,36 +137,32 @@ public:
     {
         masterImportDat toMaster;
         toMaster.slaveProc_ = -1;
-        // FDTD grid split up into y lamella see if the location is in the correct area
-        if(loc_[1] >= grids[0]->procLoc()[1] && loc_[1] < grids[0]->procLoc()[1] + grids[0]->local_y() -2) //!< Is the process in the process row that contains the lower boundary of the detector region?
+        toMaster.addIndex_ = std::vector<int>(3, 0);
+        toMaster.sz_ = std::vector<int>(3, 0);
+        bool inProc = true;
+        for(int dd = 0; dd < 3; ++dd)
         {
-            toMaster.addIndex_ = 0;
-        }
-        else if(loc_[1] < grids[0]->procLoc()[1] && loc_[1] + sz_[1] > grids[0]->procLoc()[1]) //!< Is the process in a process row that the detector region covers?
-        {
-            toMaster.addIndex_ = (grids[0]->procLoc()[1] - loc_[1]) * sz_[0]*sz_[2];
-        }
-        else
-        {
-            toMaster.addIndex_ = -1;
+            // A 2D grid has a single z layer that every process holds
+            if(grids[0]->ln_vec()[dd] == 1)
+            {
+                toMaster.sz_[dd] = 1;
+                continue;
+            }
+            // Find the part of the detector region that is inside the process in this direction
+            int start = std::max(loc_[dd], grids[0]->procLoc()[dd]);
+            int end   = std::min(loc_[dd] + sz_[dd], grids[0]->procLoc()[dd] + grids[0]->ln_vec()[dd] - 2);
+            if(start >= end)
+                inProc = false;
+            toMaster.addIndex_[dd] = start - loc_[dd];
+            toMaster.sz_[dd] = end - start;
         }
         // If the detector is in the process
-        if(toMaster.addIndex_ != -1)
-        {
-            int sz_x = loc_[0] + sz_[0] - (grids[0]->procLoc()[0] + loc_[0] - 1);
-            int sz_y = -1;
-            int sz_z = loc_[2] + sz_[2] - (grids[0]->procLoc()[2] + loc_[2] - 1);
-            if( (sz_[1] + loc_[1] > grids[0]->procLoc()[1] + grids[0]->local_y() - 2)) // Does the detector go through the end of the process' grid?
-                sz_y = grids[0]->local_y() - loc_[1] - 1;
-            else
-                sz_y = loc_[1] + sz_[1] - (grids[0]->procLoc()[1] + loc_[1] - 1);
-
-            toMaster.sz_ = sz_x*sz_y*sz_z;
+        if(inProc)
             toMaster.slaveProc_ = gridComm_->rank();
-        }
         if(gridComm_->rank() == masterProc_)
         {
-            addIndex_ =  toMaster.addIndex_;
+            addIndex_ = toMaster.addIndex_;
+            procSz_   = toMaster.sz_;
             std::vector<masterImportDat> allProcs;
             mpi::gather(*gridComm_, toMaster, allProcs, masterProc_);
             for(auto & proc : allProcs)
@@ -216,6 +214,49 @@ public:
         ++t_step_;
     }
 
+    /**
+     * @brief      Copies the Fourier transformed fields stored in this process into a vector ordered with y as the slowest and x as the fastest changing direction
+     *
+     * @param[in]  vv    index of the stored field
+     *
+     * @return     The Fourier transformed fields of all points of the detector inside this process
+     */
+    std::vector<cplx> packFreqFields(int vv)
+    {
+        std::shared_ptr<fInParam> fIn = gridsIn_[vv]->fieldInFreq();
+        // The storage copies along sz_[0] in the innermost loop, addVec1_ in the next and addVec2_ in the outermost one
+        std::array<int,3> dirs;
+        dirs[1] = std::distance(fIn->addVec1_.begin(), std::max_element(fIn->addVec1_.begin(), fIn->addVec1_.end() ) );
+        dirs[2] = std::distance(fIn->addVec2_.begin(), std::max_element(fIn->addVec2_.begin(), fIn->addVec2_.end() ) );
+        dirs[0] = 3 - dirs[1] - dirs[2];
+        std::array<int,3> szLoc;
+        for(int dd = 0; dd < 3; ++dd)
+            szLoc[dirs[dd]] = fIn->sz_[dd];
+
+        std::vector<cplx> packed(gridsIn_[vv]->outGrid()->size(), 0.0);
+        std::array<int,3> pt;
+        for(pt[1] = 0; pt[1] < szLoc[1]; ++pt[1])
+            for(pt[2] = 0; pt[2] < szLoc[2]; ++pt[2])
+                for(pt[0] = 0; pt[0] < szLoc[0]; ++pt[0])
+                    zcopy_(nfreq_, &gridsIn_[vv]->outGrid()->point(0, (pt[dirs[1]]*fIn->sz_[2] + pt[dirs[2]])*fIn->sz_[0] + pt[dirs[0]]), 1, &packed[( (pt[1]*szLoc[2] + pt[2])*szLoc[0] + pt[0] )*nfreq_], 1);
+        return packed;
+    }
+
+    /**
+     * @brief      Places the fields of one process' part of the detector into the collected fields
+     *
+     * @param[in]  vv        index of the stored field
+     * @param      packed    The fields of the process' part ordered as in packFreqFields
+     * @param[in]  addIndex  offset of the process' part from the detector's lower, left, back corner
+     * @param[in]  procSz    size of the process' part in each direction
+     */
+    void placeFreqFields(int vv, std::vector<cplx>& packed, const std::vector<int>& addIndex, const std::vector<int>& procSz)
+    {
+        for(int yy = 0; yy < procSz[1]; ++yy)
+            for(int zz = 0; zz < procSz[2]; ++zz)
+                zcopy_(nfreq_*procSz[0], &packed[(yy*procSz[2] + zz)*procSz[0]*nfreq_], 1, &freqFields_[vv]->point(0, ( (yy+addIndex[1])*sz_[2] + zz+addIndex[2] )*sz_[0] + addIndex[0]), 1);
+    }
+
     /**
      * @brief calculates the flux at the end of the calculation
      * @details uses the stored field information to Fourier transform the fields
@@ -227,21 +268,58 @@ public:
             // Copy grids into the right poistion
             if(gridComm_->rank() == masterProc_)
             {
-                zcopy_(gridsIn_[vv]->outGrid()->size(), gridsIn_[vv]->outGrid()->data(), 1, &freqFields_[vv]->point(0, addIndex_), 1);
+                std::vector<cplx> packed = packFreqFields(vv);
+                placeFreqFields(vv, packed, addIndex_, procSz_);
             }
             else if(gridsIn_[vv]->outGrid())
             {
                 // If not master proc but has some of the grid send data to master
-                std::vector<cplx> to_send(gridsIn_[vv]->outGrid()->size(),0.0);
-                zcopy_(to_send.size(), gridsIn_[vv]->outGrid()->data(), 1, to_send.data(), 1);
-                gridComm_->send(masterProc_, gridComm_->cantorTagGen(gridComm_->rank(), masterProc_, 1, 0), to_send);
+                gridComm_->send(masterProc_, gridComm_->cantorTagGen(gridComm_->rank(), masterProc_, 1, 0), packFreqFields(vv) );
             }
             for(auto& getFields : outFInfo_)
             {
                 // recv all other process's data and put it in the grid
-                std::vector<cplx> temp_store(nfreq_ * getFields->sz_,0.0);
+                std::vector<cplx> temp_store(nfreq_ * std::accumulate(getFields->sz_.begin(), getFields->sz_.end(), 1, std::multiplies<int>() ), 0.0);
                 gridComm_->recv(getFields->slaveProc_, gridComm_->cantorTagGen(getFields->slaveProc_, gridComm_->rank(), 1, 0), temp_store);
-                zcopy_(temp_store.size(), temp_store.data(), 1, &freqFields_[vv]->point(0, getFields->addIndex_), 1);
+                placeFreqFields(vv, temp_store, getFields->addIndex_, getFields->sz_);
+            }
+            // Add the fields collected before a load rebalance rebuilt the detector
+            if(gridComm_->rank() == masterProc_ && vv < carryFields_.size())
+                zaxpy_(carryFields_[vv]->size(), 1.0, carryFields_[vv]->data(), 1, freqFields_[vv]->data(), 1);
+        }
+    }
+
+    /**
+     * @brief      Takes over the Fourier transformed fields of a detector with the same parameters built for the old process boundaries
+     * @details    The old detector's fields are collected on its master process and moved to the master of this detector, where they are added to every later collection. Must be called by all processes.
+     *
+     * @param      old   The detector being replaced
+     */
+    void migrateFrom(parallelDetectorFREQ_Base<T>& old)
+    {
+        t_step_ = old.t_step_;
+        old.collectFreqFields();
+        carryFields_.clear();
+        for(int vv = 0; vv < gridsIn_.size(); ++vv)
+        {
+            if(gridComm_->rank() == masterProc_)
+            {
+                carryFields_.push_back(std::make_shared<Grid<cplx>>(std::array<int,3>({{freqFields_[vv]->x(), freqFields_[vv]->y(), 1}}), std::array<double,3>({{dOmg_, d_[0], 1.0}}) ) );
+                if(old.masterProc_ == masterProc_)
+                {
+                    zcopy_(carryFields_[vv]->size(), old.freqFields_[vv]->data(), 1, carryFields_[vv]->data(), 1);
+                }
+                else
+                {
+                    std::vector<cplx> temp_store(carryFields_[vv]->size(), 0.0);
+                    gridComm_->recv(old.masterProc_, gridComm_->cantorTagGen(old.masterProc_, masterProc_, 2, 1), temp_store);
+                    zcopy_(temp_store.size(), temp_store.data(), 1, carryFields_[vv]->data(), 1);
+                }
+            }
+            else if(gridComm_->rank() == old.masterProc_)
+            {
+                std::vector<cplx> to_send(old.freqFields_[vv]->data(), old.freqFields_[vv]->data() + old.freqFields_[vv]->size() );
+                gridComm_->send(masterProc_, gridComm_->cantorTagGen(old.masterProc_, masterProc_, 2, 1), to_send);
             }
         }
     }
@@ -405,4 +483,27 @@ public:
     parallelDetectorFREQCplx(std::string name, std::vector<pgrid_ptr> grids, std::array<int,3> loc, std::array<int,3> sz, DTCTYPE type, int timeInt, std::vector<double> freqList, std::array<double,3> d, double dt, bool SI, double I0, double a);
 };
 
+class parallelDetectorFREQFloat : public parallelDetectorFREQ_Base<float>
+{
+public:
+    /**
+     * @brief      Constructs a frequency detector based on frequencies
+     *
+     * @param[in]  name      filename of the detector
+     * @param[in]  grids     The grids used for the detector
+     * @param[in]  loc       The location of the lower, left, back corner of the detector region
+     * @param[in]  sz        size of the detector region
+     * @param[in]  type      The type: output type of dtc
+     * @param[in]  timeInt   Time interval for how often to record data
+     * @param[in]  freqList  The frequency list
+     * @param[in]  d         grid spacing in all directions
+     * @param[in]  dt        time step of the calculation
+     * @param[in]  SI        store data in SI units
+     * @param[in]  I0        unit current
+     * @param[in]  a         unit length
+     */
+    parallelDetectorFREQFloat(std::string name, std::vector<pgrid_ptr> grids, std::array<int,3> loc, std::array<int,3> sz, DTCTYPE type, int timeInt, std::vector<double> freqList, std::array<double,3> d, double dt, bool SI, double I0, double a);
+
+};
+
 #endif
\ No newline at end of file
@@ -40,14 +40,20 @@ public:
      * @param[in]  a             unit length
      * @param[in]  I0            unit current
      * @param[in]  dt            time step
+     * @param[in]  append        If true append to the output file instead of starting a new one (used when a run is continued by a rebuilt propagator)
      */
-    parallelDetectorTXTReal(std::vector<real_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt);
+    parallelDetectorTXTReal(std::vector<real_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt, bool append=false);
     /**
      * @brief Output the fields to a text file
      *
      * @param[in] t Time of the output.
      */
     void output (double t);
+
+    /**
+     * @brief      Closes the output file so another detector can append to it
+     */
+    void closeOutput() {if(outFileStream_->is_open()) outFileStream_->close();}
     /**
      * @brief returns the output file name
      */
@@ -84,14 +90,70 @@ public:
      * @param[in]  a             unit length
      * @param[in]  I0            unit current
      * @param[in]  dt            time step
+     * @param[in]  append        If true append to the output file instead of starting a new one (used when a run is continued by a rebuilt propagator)
      */
-    parallelDetectorTXTCplx(std::vector<cplx_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt );
+    parallelDetectorTXTCplx(std::vector<cplx_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt, bool append=false);
     /**
      * @brief Output the fields to a text file
      *
      * @param[in] t Time of the output.
      */
     void output (double t);
+
+    /**
+     * @brief      Closes the output file so another detector can append to it
+     */
+    void closeOutput() {if(outFileStream_->is_open()) outFileStream_->close();}
+    /**
+     * @brief returns the output file name
+     */
+    inline std::string outfile() {return outFile_;}
+};
+
+class parallelDetectorTXTFloat : public parallelDetectorBaseFloat
+{
+protected:
+    using parallelDetectorBaseFloat::timeInterval_; //!< The stride of the time (How often should the detector print?)
+    using parallelDetectorBaseFloat::tConv_; //!< conversion factor for t to get it in the correct units
+    using parallelDetectorBaseFloat::convFactor_; //!< Conversion factor for the type of output (to SI units from FDTD)
+    using parallelDetectorBaseFloat::sz_; //!< the location of the detector's lower left corner
+    using parallelDetectorBaseFloat::loc_; //!< the size in grid points of the detector
+    using parallelDetectorBaseFloat::realSpaceLoc_; //!< Location of lower, left, back corner in real spaceZ
+    using parallelDetectorBaseFloat::fields_; //!< A vector of shared pointers to each of the grids associated with the detector
+    using parallelDetectorBaseFloat::outputFunction_; //!< function to take grids and output to file in the correct manner
+
+    int t_percision_; //!< precison used to store time (easier reading of files)
+    std::string outFile_; //!< output file name
+    std::shared_ptr<std::ofstream> outFileStream_; //!< the output file stream
+
+public:
+    /**
+     * @brief      Constructs a detector that outputs to a text file
+     *
+     * @param[in]  grid          a vector of pointers to output grids
+     * @param[in]  SI            bool to determine if SI units are used
+     * @param[in]  loc           location of lower left corner of the dtc
+     * @param[in]  sz            size in grid points for the dtc
+     * @param[in]  out_name      output file name
+     * @param[in]  type          The type: output type of dtc: fields or power
+     * @param[in]  timeInterval  Time interval for how often to record data
+     * @param[in]  a             unit length
+     * @param[in]  I0            unit current
+     * @param[in]  dt            time step
+     * @param[in]  append        If true append to the output file instead of starting a new one (used when a run is continued by a rebuilt propagator)
+     */
+    parallelDetectorTXTFloat(std::vector<float_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, DTCTYPE type, double timeInterval, double a, double I0, double dt, bool append=false);
+    /**
+     * @brief Output the fields to a text file
+     *
+     * @param[in] t Time of the output.
+     */
+    void output (double t);
+
+    /**
+     * @brief      Closes the output file so another detector can append to it
+     */
+    void closeOutput() {if(outFileStream_->is_open()) outFileStream_->close();}
     /**
      * @brief returns the output file name
      */
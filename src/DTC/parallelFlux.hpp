@@ -421,6 +421,48 @@ public:
         }
     }
 
+    /**
+     * @brief      Takes over the Fourier transformed fields of a flux object with the same parameters built for the old process boundaries
+     * @details    The old fields are combined on the old output process and moved to the output process of this object. combineField adds to the frequency grids, so they are included in the final flux. Must be called by all processes.
+     *
+     * @param      old   The flux object being replaced
+     */
+    void migrateFrom(parallelFluxDTC<T>& old)
+    {
+        t_step_ = old.t_step_;
+        for(int vv = 0; vv < fInParam_.size(); ++vv)
+        {
+            old.combineField("EJ", old.Ej_freq_[vv], old.fInParam_[vv].Ej_dtc_, old.fInParam_[vv].combineEjFields_, old.fInParam_[vv].addIndex_);
+            old.combineField("EK", old.Ek_freq_[vv], old.fInParam_[vv].Ek_dtc_, old.fInParam_[vv].combineEkFields_, old.fInParam_[vv].addIndex_);
+            old.combineField("HJ", old.Hj_freq_[vv], old.fInParam_[vv].Hj_dtc_, old.fInParam_[vv].combineHjFields_, old.fInParam_[vv].addIndex_);
+            old.combineField("HK", old.Hk_freq_[vv], old.fInParam_[vv].Hk_dtc_, old.fInParam_[vv].combineHkFields_, old.fInParam_[vv].addIndex_);
+
+            std::array<cplx_grid_ptr,4> oldFreq = {{ old.Ej_freq_[vv], old.Ek_freq_[vv], old.Hj_freq_[vv], old.Hk_freq_[vv] }};
+            std::array<cplx_grid_ptr,4> newFreq = {{ Ej_freq_[vv], Ek_freq_[vv], Hj_freq_[vv], Hk_freq_[vv] }};
+            for(int cc = 0; cc < 4; ++cc)
+            {
+                if(gridComm_->rank() == outProc_ && newFreq[cc])
+                {
+                    if(old.outProc_ == outProc_)
+                    {
+                        zcopy_(newFreq[cc]->size(), oldFreq[cc]->data(), 1, newFreq[cc]->data(), 1);
+                    }
+                    else
+                    {
+                        std::vector<cplx> temp_store(newFreq[cc]->size(), 0.0);
+                        gridComm_->recv(old.outProc_, gridComm_->cantorTagGen(old.outProc_, outProc_, 4, cc), temp_store);
+                        zcopy_(temp_store.size(), temp_store.data(), 1, newFreq[cc]->data(), 1);
+                    }
+                }
+                else if(gridComm_->rank() == old.outProc_ && oldFreq[cc])
+                {
+                    std::vector<cplx> sendVec(oldFreq[cc]->data(), oldFreq[cc]->data() + oldFreq[cc]->size() );
+                    gridComm_->send(outProc_, gridComm_->cantorTagGen(old.outProc_, outProc_, 4, cc), sendVec);
+                }
+            }
+        }
+    }
+
     /**
      * @brief calculates the flux at the end of the calculation
      * @details uses the stored field infomration to fourier transform the fileds and cacluate the flux
@@ -786,4 +828,15 @@ public:
     // void fieldIn(double& tt);
     FieldInputParamsFlux makeParamIn(pgrid_ptr Ex, pgrid_ptr Ey, pgrid_ptr Ez, pgrid_ptr Hx, pgrid_ptr Hy, pgrid_ptr Hz, DIRECTION dir, bool pl);
 };
+
+class parallelFluxDTCFloat : public parallelFluxDTC<float>
+{
+    // typedef float_pgrid_ptr pgrid_ptr;
+
+public:
+    parallelFluxDTCFloat(std::shared_ptr<mpiInterface> gridComm, std::string name, double weight, pgrid_ptr Ex, pgrid_ptr Ey, pgrid_ptr Ez, pgrid_ptr Hx, pgrid_ptr Hy, pgrid_ptr Hz, std::array<int,3> loc, std::array<int,3> sz, bool cross_sec, bool save, bool load, int timeInt, std::vector<double> freqList, DIRECTION propDir, std::array<double,3> d, double dt, double theta, double phi, double psi, double alpha, std::string incd_file, bool SI, double I0, double a);
+    // void fieldIn(double& tt);
+    FieldInputParamsFlux makeParamIn(pgrid_ptr Ex, pgrid_ptr Ey, pgrid_ptr Ez, pgrid_ptr Hx, pgrid_ptr Hy, pgrid_ptr Hz, DIRECTION dir, bool pl);
+};
+
 #endif
\ No newline at end of file
@@ -310,4 +310,21 @@ public:
     void getField();
 };
 
+class parallelStorageDTCFloat : public parallelStorageDTC<float>
+{
+public:
+    /**
+     * @brief      Constructs a storage detector (field collector for outputting)
+     *
+     * @param[in]  grid  pointer to output grid
+     * @param[in]  loc   location of lower left back corner of the dtc
+     * @param[in]  sz    size in grid points for the dtc
+     */
+    parallelStorageDTCFloat(float_pgrid_ptr grid, std::array<int,3> loc, std::array<int,3> sz);
+    /**
+     * @brief      Master collects al the fields from the slave processes and puts it into the outGrid
+     */
+    void getField();
+};
+
 #endif
\ No newline at end of file
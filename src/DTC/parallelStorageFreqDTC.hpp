@@ -102,6 +102,11 @@ public:
      */
     inline cplx_grid_ptr outGrid() { return outGrid_; }
 
+    /**
+     * @return reference to fieldInFreq_
+     */
+    inline std::shared_ptr<fInParam> fieldInFreq() { return fieldInFreq_; }
+
     /**
      * @brief      Calculates the location of where to start the detector in this process
      *
@@ -294,4 +299,26 @@ public:
     void fieldIn(cplx* fftFact);
 };
 
+class parallelStorageFreqDTCFloat : public parallelStorageFreqDTC<float>
+{
+public:
+    /**
+     * @brief      construct the frequency storage dtc
+     *
+     * @param[in]  dtcNum    the detector number
+     * @param[in]  grid      pointer to output grid
+     * @param[in]  propDir   The direction of propagation
+     * @param[in]  loc       location of lower left corner of the dtc
+     * @param[in]  sz        size in grid points for the dtc
+     * @param[in]  freqList  The frequency list
+     */
+    parallelStorageFreqDTCFloat(int dtcNum, float_pgrid_ptr grid, DIRECTION propDir, std::array<int,3> loc, std::array<int,3> sz, std::vector<double> freqList);
+    /**
+     * @brief      take in fields
+     *
+     * @param      fftFact  The fourier transform factors
+     */
+    void fieldIn(cplx* fftFact);
+};
+
 #endif
\ No newline at end of file
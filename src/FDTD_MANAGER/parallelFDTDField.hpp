@@ -12,6 +12,13 @@
 #include <SOURCE/parallelSourceOblique.hpp>
 #include <SOURCE/parallelTFSF.hpp>
 #include <UTIL/FDTD_up_eq.hpp>
+#include <UTIL/FDTD_up_plan.hpp>
+#include <UTIL/FDTD_up_lor.hpp>
+#include <GRID/parallelHaloExchange.hpp>
+#include <MPI/mpiProgressThread.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /**
  * @brief The main FDTD propagator class
@@ -30,6 +37,7 @@ protected:
 
     int res_; //!< number of grid points per unit length
     int t_step_; //!< the number of time steps that happened
+    int nThreads_; //!< number of threads each process uses to work through the update lists
 
     int yExPBC_; //!< amount to extend the PBC for the Ex filed in the y direction
     int yEyPBC_; //!< amount to extend the PBC for the Ey filed in the y direction
@@ -74,6 +82,34 @@ protected:
     upLists upBy_; //!< the list of parameters used to update the By field and magnetization fields containing : std::pair(std::array<int,8>( number of elements for the calculation, x start, y start, z start, x offset for j(z) spatial derivative, y offset for j(z) spatial derivative, z offset for j(z) spatial derivative, object array index ), std::array<double,2> ( scaling factor (assumed to be 1 right now since conductivity = 0.0), spatial derivative prefactor for j spatial derivative) )
     upLists upBz_; //!< the list of parameters used to update the Bz field and magnetization fields containing : std::pair(std::array<int,8>( number of elements for the calculation, x start, y start, z start, x offset for j(x) spatial derivative, y offset for j(x) spatial derivative, z offset for j(x) spatial derivative, object array index ), std::array<double,2> ( scaling factor (assumed to be 1 right now since conductivity = 0.0), spatial derivative prefactor for j spatial derivative) )
 
+    std::vector<int> thdHx_; //!< index of the first element of upHx_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upHx_.size())
+    std::vector<int> thdHy_; //!< index of the first element of upHy_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upHy_.size())
+    std::vector<int> thdHz_; //!< index of the first element of upHz_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upHz_.size())
+
+    std::vector<int> thdEx_; //!< index of the first element of upEx_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upEx_.size())
+    std::vector<int> thdEy_; //!< index of the first element of upEy_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upEy_.size())
+    std::vector<int> thdEz_; //!< index of the first element of upEz_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upEz_.size())
+
+    std::vector<int> thdDx_; //!< index of the first element of upDx_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upDx_.size())
+    std::vector<int> thdDy_; //!< index of the first element of upDy_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upDy_.size())
+    std::vector<int> thdDz_; //!< index of the first element of upDz_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upDz_.size())
+
+    std::vector<int> thdBx_; //!< index of the first element of upBx_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upBx_.size())
+    std::vector<int> thdBy_; //!< index of the first element of upBy_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upBy_.size())
+    std::vector<int> thdBz_; //!< index of the first element of upBz_ each thread updates (split into the runs that do not need the transfer regions followed by the ones that do, the last element is upBz_.size())
+
+    bool usePlans_; //!< True if the curl updates are done with curlPlans_ instead of upHxFxn_, etc.
+    bool resumeOutput_; //!< True if the propagator continues a run of another propagator (detectors append to its files and skip the time 0 output)
+    std::array<curlUpdatePlan<T>,12> curlPlans_; //!< the Hx, Hy, Hz, Ex, Ey, Ez, Bx, By, Bz, Dx, Dy, and Dz update lists compiled into flat plans (same run order as the lists, neighboring runs are merged by the cell kernels)
+    std::array<std::shared_ptr<lorentzPoleStore<T>>,6> poleStores_; //!< interleaved pole storage for the Dx, Dy, Dz, Bx, By, and Bz update lists used by the fused dispersive updates (nullptr if the blas updates are used); lorPx_, etc. are then only made if a detector outputs them and are filled from the stores before outputs
+    bool polOutput_; //!< True if a detector outputs the polarization or magnetization fields
+
+    int timeTile_; //!< maximum number of time steps advanced at once by stepTile (1 if the temporally blocked update is off)
+    std::vector<int> tileSlabY_; //!< first y row of each slab used by the temporally blocked update, the last element is one past the last row
+    std::array<upLists,6> tileUp_; //!< copies of the Hx, Hy, Hz, Ex, Ey, and Ez update lists sorted by their y row for the temporally blocked update
+    std::array<std::vector<int>,6> tileSlabRuns_; //!< index of the first run of each slab in the lists of tileUp_, the last element is the size of the list
+    std::vector<int> tileSrcSlab_; //!< the slab containing each source in srcArr_
+
     std::function<void( std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr )> upHxFxn_; //!< function that will update the Hx field
     std::function<void( std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr )> upHyFxn_; //!< function that will update the Hy field
     std::function<void( std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr )> upHzFxn_; //!< function that will update the Hz field
@@ -106,13 +142,9 @@ protected:
     std::function< void( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj>) > B2HyFxn_; //!< function that will convert the Dy field to the Ey fields
     std::function< void( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj>) > B2HzFxn_; //!< function that will convert the Dz field to the Ez fields
 
-    std::function< void() > transferEx_; //!< function used to communicate the border values of the Ex field to each processor (either a simple return or Ex_->transferData() depending on circumstances)
-    std::function< void() > transferEy_; //!< function used to communicate the border values of the Ey field to each processor (either a simple return or Ey_->transferData() depending on circumstances)
-    std::function< void() > transferEz_; //!< function used to communicate the border values of the Ez field to each processor (either a simple return or Ez_->transferData() depending on circumstances)
-
-    std::function< void() > transferHx_; //!< function used to communicate the border values of the Hx field to each processor (either a simple return or Hx_->transferData() depending on circumstances)
-    std::function< void() > transferHy_; //!< function used to communicate the border values of the Hy field to each processor (either a simple return or Hy_->transferData() depending on circumstances)
-    std::function< void() > transferHz_; //!< function used to communicate the border values of the Hz field to each processor (either a simple return or Hz_->transferData() depending on circumstances)
+    std::shared_ptr<parallelHaloExchange<T>> transferE_; //!< exchanges the border values of all E fields with the neighboring processes in one message per neighbor
+    std::shared_ptr<parallelHaloExchange<T>> transferH_; //!< exchanges the border values of all H fields with the neighboring processes in one message per neighbor
+    std::shared_ptr<mpiProgressThread> progress_; //!< polls MPI while the updates overlap with the halo exchanges (nullptr if off)
 
     std::function<void(pgrid_ptr, std::array<double, 3>&, int, int, int, int, int, int, int, double&, double&, double&)> pbcEx_; //!< function to apply PBC for the Ex field
     std::function<void(pgrid_ptr, std::array<double, 3>&, int, int, int, int, int, int, int, double&, double&, double&)> pbcEy_; //!< function to apply PBC for the Ey field
@@ -129,12 +161,12 @@ protected:
     std::vector<cplx> H_incd_; //!< vector of all the incident H field values
     std::vector<cplx> H_mn_incd_; //!< vector of all the incident H field values one point behind the TFSF source start
 
-    std::vector<T> scratch_; //!< vector for scratch operations
+    std::vector<T> scratch_; //!< vector for scratch operations (one block of equal size for each thread)
 
     std::array<int,8> axParams_; //!< Temp array to store all the axpy parameters for field updates
     std::array<double,2> prefactors_; //!< Temp array to store all the prefactor parameters for field updates
 
-    std::vector<real_grid_ptr> weights_; //!< a map of the weights for each of the x y and z fields used to determine how to split up the grids for parallelization
+    planeWeightSums weights_; //!< the summed weights of the planes normal to x, y, and z used to determine how to split up the grids for parallelization
 
     std::vector< std::shared_ptr< parallelDetectorFREQ_Base< T > > > dtcFreqArr_; //!< vector storing all dtcFREQ objects
     std::vector< std::shared_ptr< parallelFluxDTC< T > > > fluxArr_; //!< vector storing all flux objects
@@ -157,13 +189,13 @@ public:
     pgrid_ptr Ey_; //!< parallel grid corresponding to the Ey field
     pgrid_ptr Ez_; //!< parallel grid corresponding to the Ez field
 
-    pgrid_ptr Bx_; //!< parallel grid corresponding to the Dx field
-    pgrid_ptr By_; //!< parallel grid corresponding to the Dy field
-    pgrid_ptr Bz_; //!< parallel grid corresponding to the Dz field
+    pgrid_ptr Bx_; //!< parallel grid corresponding to the Dx field (only the rows with dispersive or magnetic cells are stored, see restrictAuxRows)
+    pgrid_ptr By_; //!< parallel grid corresponding to the Dy field (only the rows with dispersive or magnetic cells are stored, see restrictAuxRows)
+    pgrid_ptr Bz_; //!< parallel grid corresponding to the Dz field (only the rows with dispersive or magnetic cells are stored, see restrictAuxRows)
 
-    pgrid_ptr Dx_; //!< parallel grid corresponding to the Dx field
-    pgrid_ptr Dy_; //!< parallel grid corresponding to the Dy field
-    pgrid_ptr Dz_; //!< parallel grid corresponding to the Dz field
+    pgrid_ptr Dx_; //!< parallel grid corresponding to the Dx field (only the rows with dispersive or magnetic cells are stored, see restrictAuxRows)
+    pgrid_ptr Dy_; //!< parallel grid corresponding to the Dy field (only the rows with dispersive or magnetic cells are stored, see restrictAuxRows)
+    pgrid_ptr Dz_; //!< parallel grid corresponding to the Dz field (only the rows with dispersive or magnetic cells are stored, see restrictAuxRows)
 
     std::vector<pgrid_ptr> lorPx_; //!< a vector of Polarization fields for the x direction at the current time step
     std::vector<pgrid_ptr> lorPy_; //!< a vector of Polarization fields for the y direction at the current time step
@@ -200,6 +232,7 @@ public:
         magMatInPML_(false),
         res_(IP.res_),
         t_step_(0),
+        nThreads_(IP.nThreads_),
         yExPBC_(0),
         yEyPBC_(0),
         yEzPBC_(0),
@@ -213,11 +246,20 @@ public:
         dt_(IP.courant_ * d_[0]),
         tcur_(0),
         n_vec_( toN_vec(IP.size_ ) ),
-        scratch_((n_vec_[0]+n_vec_[1]) * 2.0, 0.0),
+        scratch_((n_vec_[0]+n_vec_[1]) * 2 * IP.nThreads_, 0.0),
         objArr_(IP.objArr_),
         k_point_(IP.k_point_),
+        usePlans_(false),
+        resumeOutput_(IP.resumeOutput_),
+        polOutput_(false),
+        timeTile_(1),
         weights_()
     {
+        // The E and H halo exchanges get their fields once the grids are made (exchange ID separates their message tags)
+        transferE_ = std::make_shared<parallelHaloExchange<T>>(gridComm_, 0, IP.sharedHalo_);
+        transferH_ = std::make_shared<parallelHaloExchange<T>>(gridComm_, 1, IP.sharedHalo_);
+        if(IP.progressThread_)
+            progress_ = std::make_shared<mpiProgressThread>(gridComm_, IP.progressInterval_);
         // Reserve memory for all object vectors
         dtcArr_.reserve( IP.dtcLoc_.size() );
         srcArr_.reserve( IP.srcLoc_.size() );
@@ -230,7 +272,7 @@ public:
         H_incd_   .reserve( ceil(IP.tMax_ / dt_ ) + 1 );
         H_mn_incd_.reserve( ceil(IP.tMax_ / dt_ ) + 1 );
 
-        // Set up weights to scale where the process boundaries should be located (based on Instruction Calls for various objects)
+        // Set up the plane weights to scale where the process boundaries should be located (based on the costs of the updates at each point)
         setupWeightsGrid(IP);
 
         // If only a 2D calculation set the number of points in the z direction to 1, otherwise like any other direction
@@ -361,10 +403,14 @@ public:
             {
                 Dx_ = std::make_shared<parallelGrid<T>> (gridComm_, IP.periodic_, weights_, std::array<int,3>({{ n_vec_[0]+2*gridComm_->npX(), n_vec_[1]+2*gridComm_->npY(), nz }}), d_, false);
                 Dy_ = std::make_shared<parallelGrid<T>> (gridComm_, IP.periodic_, weights_, std::array<int,3>({{ n_vec_[0]+2*gridComm_->npX(), n_vec_[1]+2*gridComm_->npY(), nz }}), d_, true);
+                // D and B are only used by the dispersive and magnetic update lists so only the rows holding those cells are stored
+                restrictAuxRows(Dx_, phys_Ex_, true);
+                restrictAuxRows(Dy_, phys_Ey_, true);
             }
             if(magnetic)
             {
                 Bz_ = std::make_shared<parallelGrid<T>> (gridComm_, IP.periodic_, weights_, std::array<int,3>({{ n_vec_[0]+2*gridComm_->npX(), n_vec_[1]+2*gridComm_->npY(), nz }}), d_, true);
+                restrictAuxRows(Bz_, phys_Hz_, false);
             }
             ln_vec_[0] = Hz_->local_x()-2;
             ln_vec_[1] = Hz_->local_y()-2;
@@ -380,11 +426,14 @@ public:
             if(disp)
             {
                 Dz_ = std::make_shared<parallelGrid<T>> (gridComm_, IP.periodic_, weights_, std::array<int,3>({{ n_vec_[0]+2*gridComm_->npX(), n_vec_[1]+2*gridComm_->npY(),  nz }}), d_, false);
+                restrictAuxRows(Dz_, phys_Ez_, true);
             }
             if(magnetic)
             {
                 Bx_ = std::make_shared<parallelGrid<T>> (gridComm_, IP.periodic_, weights_, std::array<int,3>({{ n_vec_[0]+2*gridComm_->npX(), n_vec_[1]+2*gridComm_->npY(),  nz }}), d_, true);
                 By_ = std::make_shared<parallelGrid<T>> (gridComm_, IP.periodic_, weights_, std::array<int,3>({{ n_vec_[0]+2*gridComm_->npX(), n_vec_[1]+2*gridComm_->npY(),  nz }}), d_, false);
+                restrictAuxRows(Bx_, phys_Hx_, false);
+                restrictAuxRows(By_, phys_Hy_, false);
             }
             ln_vec_[0] = Ez_->local_x()-2;
             ln_vec_[1] = Ez_->local_y()-2;
@@ -392,11 +441,14 @@ public:
         }
         pbcZMin_ = (nz == 1) ? 0 : 1;
         pbcZMax_ = (nz == 1) ? 1 : ln_vec_[2];
-        // Initialize object specific grids
+        // Initialize object specific grids, the fused dispersive updates keep the poles in compact stores so the full pole grids are only made for the blas updates and for detectors that output them
+        for(auto& type : IP.dtcType_)
+            polOutput_ = polOutput_ || type == DTCTYPE::PX || type == DTCTYPE::PY || type == DTCTYPE::PZ || type == DTCTYPE::MX || type == DTCTYPE::MY || type == DTCTYPE::MZ;
+        bool poleGrids = (IP.curlKernel_ == CURLKERNEL::BLAS) || polOutput_;
         for(auto & obj :objArr_)
         {
             obj->setUpConsts(dt_);
-            while((obj->mat().size() - 1) / 3.0 > lorPx_.size())
+            while(poleGrids && (obj->mat().size() - 1) / 3.0 > lorPx_.size())
             {
                 if(Dx_)
                 {
@@ -411,7 +463,7 @@ public:
                     prevLorPz_.push_back(std::make_shared<parallelGrid<T>>(gridComm_, false, weights_, std::array<int,3>( {{ n_vec_[0]+2*gridComm_->npX(),n_vec_[1]+2*gridComm_->npY(), nz }} ), d_, false) );
                 }
             }
-            while((obj->magMat().size() - 1) / 3.0 > lorMx_.size())
+            while(poleGrids && (obj->magMat().size() - 1) / 3.0 > lorMx_.size())
             {
                 if(Bx_)
                 {
@@ -458,7 +510,7 @@ public:
             double ep_mu = E ? objArr_[up[4]]->epsInfty() : objArr_[up[4]]->muInfty();
             if( up[1] + physGrid->procLoc()[1] != fieldEnd[1] && up[2] + physGrid->procLoc()[2] != fieldEnd[2] )
             {
-                if(up[3] + up[0] - 1 == fieldEnd[0])
+                if(up[3] + up[0] - 1 + physGrid->procLoc()[0] == fieldEnd[0])
                     upU.push_back(std::make_pair(std::array<int,8>({up[3]-1, up[0], up[1], up[2], derivOff[0], derivOff[1] , derivOff[2], up[4]}), std::array<double,2>({1.0, -1.0*dt_/(ep_mu*d)}) ) );
                 else
                     upU.push_back(std::make_pair(std::array<int,8>({up[3]  , up[0], up[1], up[2], derivOff[0], derivOff[1] , derivOff[2], up[4]}), std::array<double,2>({1.0, -1.0*dt_/(ep_mu*d)}) ) );
@@ -468,7 +520,7 @@ public:
         {
             if( up[1] + physGrid->procLoc()[1] != fieldEnd[1] && up[2] + physGrid->procLoc()[2] != fieldEnd[2] )
             {
-                if(up[3] + up[0] - 1 == fieldEnd[0])
+                if(up[3] + up[0] - 1 + physGrid->procLoc()[0] == fieldEnd[0])
                     upD.push_back(std::make_pair(std::array<int,8>({up[3]-1, up[0], up[1], up[2], derivOff[0], derivOff[1] , derivOff[2], up[4]}), std::array<double,2>({1.0, -1.0*dt_/d}) ) );
                 else
                     upD.push_back(std::make_pair(std::array<int,8>({up[3]  , up[0], up[1], up[2], derivOff[0], derivOff[1] , derivOff[2], up[4]}), std::array<double,2>({1.0, -1.0*dt_/d}) ) );
@@ -476,6 +528,736 @@ public:
         }
     }
 
+    /**
+     * @brief      Splits part of an update list into contiguous blocks of roughly equal work (total run length) for each thread
+     *
+     * @param[in]  up     The update list to split
+     * @param[in]  first  The first element of the part of the list to split
+     * @param[in]  last   One past the last element of the part of the list to split
+     *
+     * @return     The index of the first list element for each thread, with last appended as the end of the last block
+     */
+    std::vector<int> getThreadBounds(const upLists& up, int first, int last)
+    {
+        std::vector<int> bounds(nThreads_+1, last);
+        bounds[0] = first;
+        double totWork = 0.0;
+        for(int ii = first; ii < last; ++ii)
+            totWork += std::get<0>(up[ii])[0];
+        // Start a new block once the running work passes the next tt/nThreads_ fraction of the total
+        double work = 0.0;
+        int tt = 1;
+        for(int ii = first; ii < last && tt < nThreads_; ++ii)
+        {
+            work += std::get<0>(up[ii])[0];
+            while(tt < nThreads_ && work >= totWork * static_cast<double>(tt) / static_cast<double>(nThreads_) )
+            {
+                bounds[tt] = ii+1;
+                ++tt;
+            }
+        }
+        return bounds;
+    }
+
+    /**
+     * @brief      Moves the update list runs that read the transfer regions filled by other processes to the end of the list
+     * @details    Runs along the x direction only touch the x transfer regions at their end points, so those points are split off into their own runs.
+     *
+     * @param      up         The update list
+     * @param[in]  grid       A grid with the same layout as the fields being updated
+     * @param[in]  upRecvRow  The lowest y row any of the fields read by the list receives from the UP process
+     *
+     * @return     The number of runs at the start of the list that do not need the transfer regions
+     */
+    int splitHaloRuns(upLists& up, pgrid_ptr grid, int upRecvRow)
+    {
+        std::array<int,6> neigh = grid->procNeigh();
+        std::array<int,3> ln = grid->ln_vec();
+        upLists inner, halo;
+        for(auto& run : up)
+        {
+            std::array<int,8> ax = std::get<0>(run);
+            // The j field is read at (x+ax[6], y+ax[4], z+ax[5]) and the k field at (x+ax[4], y+ax[5], z+ax[6])
+            std::array<int,3> offMin = {{ std::min({0, ax[6], ax[4]}), std::min({0, ax[4], ax[5]}), std::min({0, ax[5], ax[6]}) }};
+            std::array<int,3> offMax = {{ std::max({0, ax[6], ax[4]}), std::max({0, ax[4], ax[5]}), std::max({0, ax[5], ax[6]}) }};
+            bool needY = ( neigh[static_cast<int>(PROC_DIR::DOWN)] != -1 && ax[2] + offMin[1] <= 0 ) || ( neigh[static_cast<int>(PROC_DIR::UP   )] != -1 && ax[2] + offMax[1] >= upRecvRow );
+            bool needZ = ( neigh[static_cast<int>(PROC_DIR::BACK)] != -1 && ax[3] + offMin[2] <= 0 ) || ( neigh[static_cast<int>(PROC_DIR::FRONT)] != -1 && ax[3] + offMax[2] >= ln[2]-1 );
+            if(needY || needZ)
+            {
+                halo.push_back(run);
+                continue;
+            }
+            if(neigh[static_cast<int>(PROC_DIR::LEFT)] != -1 && ax[1] + offMin[0] <= 0)
+            {
+                halo.push_back(std::make_pair(std::array<int,8>({{1, ax[1], ax[2], ax[3], ax[4], ax[5], ax[6], ax[7]}}), std::get<1>(run) ) );
+                ax[1] += 1;
+                ax[0] -= 1;
+            }
+            if(ax[0] > 0 && neigh[static_cast<int>(PROC_DIR::RIGHT)] != -1 && ax[1] + ax[0] - 1 + offMax[0] >= ln[0]-1)
+            {
+                halo.push_back(std::make_pair(std::array<int,8>({{1, ax[1] + ax[0] - 1, ax[2], ax[3], ax[4], ax[5], ax[6], ax[7]}}), std::get<1>(run) ) );
+                ax[0] -= 1;
+            }
+            if(ax[0] > 0)
+                inner.push_back(std::make_pair(ax, std::get<1>(run) ) );
+        }
+        int nInner = inner.size();
+        inner.insert(inner.end(), halo.begin(), halo.end());
+        up = inner;
+        return nInner;
+    }
+
+    /**
+     * @brief      Gets the thread bounds for an update list after moving the runs that need the transfer regions to the end
+     *
+     * @param      up         The update list
+     * @param[in]  grid       A grid with the same layout as the fields being updated
+     * @param[in]  upRecvRow  The lowest y row any of the fields read by the list receives from the UP process
+     *
+     * @return     2*nThreads_+1 bounds, the first nThreads_+1 split the runs that do not need the transfer regions and the last nThreads_+1 split the ones that do
+     */
+    std::vector<int> getThreadHaloBounds(upLists& up, pgrid_ptr grid, int upRecvRow)
+    {
+        int nInner = splitHaloRuns(up, grid, upRecvRow);
+        std::vector<int> bounds = getThreadBounds(up, 0, nInner);
+        std::vector<int> haloBounds = getThreadBounds(up, nInner, up.size());
+        bounds.insert(bounds.end(), haloBounds.begin()+1, haloBounds.end());
+        return bounds;
+    }
+
+    /**
+     * @brief      Sets up the thread bounds for all update lists, must be called after all update lists are initialized
+     */
+    void setupThreadBounds()
+    {
+        pgrid_ptr grid = Ex_ ? Ex_ : Hx_;
+        // With periodic boundaries the fields limited in y receive the UP transfer one row lower on the last process in y
+        int upRecvRow = grid->local_y()-1;
+        for(auto& fld : {Ex_, Ey_, Ez_, Hx_, Hy_, Hz_})
+            if(fld)
+                upRecvRow = std::min(upRecvRow, fld->upRecvIndex() );
+        thdHx_ = getThreadHaloBounds(upHx_, grid, upRecvRow);
+        thdHy_ = getThreadHaloBounds(upHy_, grid, upRecvRow);
+        thdHz_ = getThreadHaloBounds(upHz_, grid, upRecvRow);
+
+        thdEx_ = getThreadHaloBounds(upEx_, grid, upRecvRow);
+        thdEy_ = getThreadHaloBounds(upEy_, grid, upRecvRow);
+        thdEz_ = getThreadHaloBounds(upEz_, grid, upRecvRow);
+
+        thdDx_ = getThreadHaloBounds(upDx_, grid, upRecvRow);
+        thdDy_ = getThreadHaloBounds(upDy_, grid, upRecvRow);
+        thdDz_ = getThreadHaloBounds(upDz_, grid, upRecvRow);
+
+        thdBx_ = getThreadHaloBounds(upBx_, grid, upRecvRow);
+        thdBy_ = getThreadHaloBounds(upBy_, grid, upRecvRow);
+        thdBz_ = getThreadHaloBounds(upBz_, grid, upRecvRow);
+    }
+
+    /**
+     * @brief      Compiles the update lists into flat plans if the plan kernels are used, sets up the fused PML and dispersive updates for all but the blas kernels, and prints the run length statistics if requested, must be called after setupThreadBounds
+     *
+     * @param[in]  IP    The input parameter object
+     */
+    void setupCurlPlans(const parallelProgramInputs &IP)
+    {
+        usePlans_ = (IP.curlKernel_ == CURLKERNEL::PLAN || IP.curlKernel_ == CURLKERNEL::CELL);
+        // The cell kernels merge the runs split by material boundaries into whole rows that look up the prefactor of each point
+        bool merge = (IP.curlKernel_ == CURLKERNEL::CELL);
+        if(usePlans_)
+        {
+            curlPlans_ = {{
+                curlUpdatePlan<T>(upHx_, thdHx_, merge, Hx_, Ey_, Ez_), curlUpdatePlan<T>(upHy_, thdHy_, merge, Hy_, Ez_, Ex_), curlUpdatePlan<T>(upHz_, thdHz_, merge, Hz_, Ex_, Ey_),
+                curlUpdatePlan<T>(upEx_, thdEx_, merge, Ex_, Hy_, Hz_), curlUpdatePlan<T>(upEy_, thdEy_, merge, Ey_, Hz_, Hx_), curlUpdatePlan<T>(upEz_, thdEz_, merge, Ez_, Hx_, Hy_),
+                curlUpdatePlan<T>(upBx_, thdBx_, merge, Bx_, Ey_, Ez_), curlUpdatePlan<T>(upBy_, thdBy_, merge, By_, Ez_, Ex_), curlUpdatePlan<T>(upBz_, thdBz_, merge, Bz_, Ex_, Ey_),
+                curlUpdatePlan<T>(upDx_, thdDx_, merge, Dx_, Hy_, Hz_), curlUpdatePlan<T>(upDy_, thdDy_, merge, Dy_, Hz_, Hx_), curlUpdatePlan<T>(upDz_, thdDz_, merge, Dz_, Hx_, Hy_)
+            }};
+        }
+        // The fused curl kernels also update the PMLs in a single pass per run
+        if(IP.curlKernel_ != CURLKERNEL::BLAS)
+        {
+            for(auto& pml : {ExPML_, EyPML_, EzPML_, HxPML_, HyPML_, HzPML_})
+                if(pml)
+                    pml->useFusedKernel();
+            // The dispersive updates use interleaved pole storage that follows the (now fixed) order of the D and B update lists, Drude poles are folded into D and B unless the polarizations are output
+            std::array<upLists*,6> dispLists = {{ &upDx_, &upDy_, &upDz_, &upBx_, &upBy_, &upBz_ }};
+            std::array<pgrid_ptr,6> dispGrids = {{ Dx_, Dy_, Dz_, Bx_, By_, Bz_ }};
+            for(int ss = 0; ss < 6; ++ss)
+                if(dispGrids[ss])
+                    poleStores_[ss] = std::make_shared<lorentzPoleStore<T>>(*dispLists[ss], objArr_, ss >= 3, !polOutput_);
+        }
+        if(IP.curlKernel_ == CURLKERNEL::SIMD && gridComm_->rank() == 0)
+            std::cout << "Using the " << curlSIMD::isaName(curlSIMD::isa() ) << " curl kernels" << std::endl;
+        if(!IP.runLengthReport_)
+            return;
+        // Sum the statistics over all processes so the report shows the fragmentation of the whole cell
+        const int nBins = 12;
+        std::array<std::string,12> names = {{ "Hx", "Hy", "Hz", "Ex", "Ey", "Ez", "Bx", "By", "Bz", "Dx", "Dy", "Dz" }};
+        std::array<upLists*,12> lists = {{ &upHx_, &upHy_, &upHz_, &upEx_, &upEy_, &upEz_, &upBx_, &upBy_, &upBz_, &upDx_, &upDy_, &upDz_ }};
+        if(gridComm_->rank() == 0)
+            std::cout << "Update list run lengths (runs with lengths 1, 2-3, 4-7, ..., >=" << (1 << (nBins-1) ) << "):" << std::endl;
+        for(int ll = 0; ll < lists.size(); ++ll)
+        {
+            std::vector<int> hist = curlUpdatePlan<T>::runLengthHist(*lists[ll], nBins);
+            std::vector<long> locStats(hist.begin(), hist.end() );
+            locStats.push_back(0);
+            for(auto& run : *lists[ll])
+                locStats.back() += std::get<0>(run)[0];
+            locStats.push_back(usePlans_ ? curlPlans_[ll].nRuns() : 0);
+            std::vector<long> stats(locStats.size(), 0);
+            mpi::all_reduce(*gridComm_, locStats.data(), locStats.size(), stats.data(), std::plus<long>() );
+            long nRuns = std::accumulate(stats.begin(), stats.begin()+nBins, 0l);
+            if(gridComm_->rank() != 0 || nRuns == 0)
+                continue;
+            std::cout << names[ll] << ": " << nRuns << " runs, " << stats[nBins] << " points, mean length " << static_cast<double>(stats[nBins] ) / static_cast<double>(nRuns) << ", hist:";
+            for(int bb = 0; bb < nBins; ++bb)
+                std::cout << " " << stats[bb];
+            if(usePlans_)
+                std::cout << ", " << stats[nBins+1] << " runs after compiling";
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * @brief      Sets up the slabs used by stepTile, must be called after all update lists and sources are constructed
+     * @details    The curl, PML, TFSF, and soft source updates are all row local and are done slab by slab. The halo exchanges, periodic boundaries, and dispersive updates work on the whole grid at once, so the blocking can not be used with them.
+     *
+     * @param[in]  IP    The input parameter object
+     */
+    void setupTiling(const parallelProgramInputs &IP)
+    {
+        timeTile_ = IP.timeTile_;
+        if(timeTile_ == 1)
+            return;
+        if(gridComm_->size() > 1)
+            throw std::logic_error("CompCell.timeTile can only be used with a single process");
+        if(IP.periodic_)
+            throw std::logic_error("CompCell.timeTile can not be used with periodic boundary conditions");
+        if(upDx_.size() + upDy_.size() + upDz_.size() + upBx_.size() + upBy_.size() + upBz_.size() > 0)
+            throw std::logic_error("CompCell.timeTile can not be used with dispersive materials");
+        pgrid_ptr grid = Ex_ ? Ex_ : Hx_;
+        int lny = grid->ln_vec()[1];
+        // Local y ranges of all sources, their pulses are added to the whole source at once so no slab boundary can cut through one
+        std::vector<std::array<int,2>> srcY;
+        for(auto& src : srcArr_)
+        {
+            int y0 = src->loc()[1] - src->grid()->procLoc()[1] + 1;
+            srcY.push_back( {{ y0, y0 + std::max(src->sz()[1], 1) }} );
+        }
+        tileSlabY_ = {0};
+        for(int yy = 1; yy < lny; yy += IP.tileRows_)
+        {
+            if(yy == 1 || std::any_of(srcY.begin(), srcY.end(), [yy](const std::array<int,2>& sy){return sy[0] < yy && yy < sy[1];} ) )
+                continue;
+            tileSlabY_.push_back(yy);
+        }
+        tileSlabY_.push_back(lny);
+
+        tileUp_ = {{ upHx_, upHy_, upHz_, upEx_, upEy_, upEz_ }};
+        for(int cc = 0; cc < 6; ++cc)
+        {
+            std::stable_sort(tileUp_[cc].begin(), tileUp_[cc].end(), [](const std::pair<std::array<int,8>, std::array<double,2>>& a, const std::pair<std::array<int,8>, std::array<double,2>>& b){return std::get<0>(a)[2] < std::get<0>(b)[2];} );
+            tileSlabRuns_[cc].resize(tileSlabY_.size() );
+            for(int ss = 0; ss < tileSlabY_.size(); ++ss)
+                tileSlabRuns_[cc][ss] = std::lower_bound(tileUp_[cc].begin(), tileUp_[cc].end(), tileSlabY_[ss], [](const std::pair<std::array<int,8>, std::array<double,2>>& run, int yy){return std::get<0>(run)[2] < yy;} ) - tileUp_[cc].begin();
+        }
+        tileSrcSlab_.clear();
+        for(auto& sy : srcY)
+            tileSrcSlab_.push_back(std::min<int>(std::upper_bound(tileSlabY_.begin(), tileSlabY_.end(), std::max(sy[0], 0) ) - tileSlabY_.begin(), tileSlabY_.size()-1) - 1);
+        for(auto& pml : {HxPML_, HyPML_, HzPML_, ExPML_, EyPML_, EzPML_})
+            if(pml)
+                pml->setupSlabs(tileSlabY_);
+        for(auto& tfsf : tfsfArr_)
+            tfsf->setupSlabs(tileSlabY_);
+    }
+
+    /**
+     * @return     The index of the calling thread inside a parallel region (always 0 without OpenMP)
+     */
+    inline int threadID()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @return     Pointer to the start of the scratch space for the calling thread
+     */
+    inline T* threadScratch() { return scratch_.data() + threadID() * (scratch_.size() / nThreads_); }
+
+    /**
+     * @brief      Sets up the parts of the propagator that are the same for all field types: the PMLs, update lists, halo exchanges, sources, TFSF surfaces, flux regions and detectors
+     * @details    The constructor of the derived class sets the update functions of the modes it uses before calling this, the update functions of the unused modes are set to do nothing here
+     *
+     * @param      IP          The input parameter object
+     *
+     * @tparam     CPML        The PML class for the field type
+     * @tparam     SRCNORMAL   The soft source class for sources along the grid axes
+     * @tparam     SRCOBLIQUE  The soft source class for oblique sources
+     * @tparam     TFSF        The TFSF surface class
+     * @tparam     FLUX        The flux region class
+     */
+    template <typename CPML, typename SRCNORMAL, typename SRCOBLIQUE, typename TFSF, typename FLUX> void setupPropagator(parallelProgramInputs &IP)
+    {
+        // If there is an Hz field set up all TE mode functions otherwise set them to do nothing
+        if(Hz_)
+        {
+            // Initialize the PMLs
+            if(magMatInPML_)
+            {
+                HzPML_   = std::make_shared<CPML>(gridComm_, weights_, Bz_, Ex_, Ey_, POLARIZATION::HZ, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Hz_, objArr_);
+            }
+            else
+            {
+                HzPML_   = std::make_shared<CPML>(gridComm_, weights_, Hz_, Ex_, Ey_, POLARIZATION::HZ, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Hz_, objArr_);
+            }
+            if(dielectricMatInPML_)
+            {
+                ExPML_   = std::make_shared<CPML>(gridComm_, weights_, Dx_, Hy_, Hz_, POLARIZATION::EX, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Ex_, objArr_);
+                EyPML_   = std::make_shared<CPML>(gridComm_, weights_, Dy_, Hz_, Hx_, POLARIZATION::EY, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Ey_, objArr_);
+            }
+            else
+            {
+                ExPML_   = std::make_shared<CPML>(gridComm_, weights_, Ex_, Hy_, Hz_, POLARIZATION::EX, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Ex_, objArr_);
+                EyPML_   = std::make_shared<CPML>(gridComm_, weights_, Ey_, Hz_, Hx_, POLARIZATION::EY, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Ey_, objArr_);
+            }
+            // Fill the update Lists
+            initializeList(phys_Hz_, HzPML_, false, std::array<int,3>( {{ 1,  0,  0 }} ), std::array<int,3>( {{n_vec_[0]  , n_vec_[1]  , n_vec_[2]+1 }} ), d_[0], upHz_, upBz_);
+            initializeList(phys_Ex_, ExPML_,  true, std::array<int,3>( {{ 0, -1,  0 }} ), std::array<int,3>( {{n_vec_[0]  , n_vec_[1]+1, n_vec_[2]+1 }} ), d_[1], upEx_, upDx_);
+            initializeList(phys_Ey_, EyPML_,  true, std::array<int,3>( {{ 0,  0, -1 }} ), std::array<int,3>( {{n_vec_[0]+1, n_vec_[1]  , n_vec_[2]+1 }} ), d_[0], upEy_, upDy_);
+
+            updateExPML_ = [](pml_ptr pml){pml->updateGrid();};
+            updateEyPML_ = [](pml_ptr pml){pml->updateGrid();};
+            updateHzPML_ = [](pml_ptr pml){pml->updateGrid();};
+
+            if(IP.periodic_ && gridComm_->size() > 1)
+            {
+                yExPBC_ = ln_vec_[1]+1;
+                yEyPBC_ = ln_vec_[1]+1;
+                yHzPBC_ = ln_vec_[1]+1;
+                // Field definition buffer
+                if(gridComm_->npY()-1 == gridComm_->mypY())
+                {
+                    yHzPBC_ -= 1;
+                    yEyPBC_ -= 1;
+                }
+            }
+            else if(IP.periodic_)
+            {
+                yHzPBC_ = ln_vec_[1];
+                yExPBC_ = ln_vec_[1]+1;
+                yEyPBC_ = ln_vec_[1];
+            }
+            else
+            {
+                pbcEx_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+                pbcEy_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+                pbcHz_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+            }
+
+            // Add the fields to the halo exchanges, they should do nothing if only on one processor
+            if(gridComm_->size() > 1)
+            {
+                transferE_->addGrid(Ex_);
+                transferE_->addGrid(Ey_);
+                transferH_->addGrid(Hz_);
+            }
+        }
+        else
+        {
+            upHzFxn_ = [](std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr){return;};
+
+            upExFxn_ = [](std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr){return;};;
+            upEyFxn_ = [](std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr){return;};;
+
+            updateExPML_ = [](pml_ptr pml){return;};
+            updateEyPML_ = [](pml_ptr pml){return;};
+            updateHzPML_ = [](pml_ptr pml){return;};
+
+            upLorPxFxn_ = []( std::array<int,8>&, pgrid_ptr, std::vector<pgrid_ptr>&, std::vector<pgrid_ptr>&, T*, std::shared_ptr<Obj> ){return;};
+            upLorPyFxn_ = []( std::array<int,8>&, pgrid_ptr, std::vector<pgrid_ptr>&, std::vector<pgrid_ptr>&, T*, std::shared_ptr<Obj> ){return;};
+            upLorMzFxn_ = []( std::array<int,8>&, pgrid_ptr, std::vector<pgrid_ptr>&, std::vector<pgrid_ptr>&, T*, std::shared_ptr<Obj> ){return;};
+
+            D2ExFxn_ = []( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj> ){return;};
+            D2EyFxn_ = []( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj> ){return;};
+            B2HzFxn_ = []( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj> ){return;};
+
+            pbcEx_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+            pbcEy_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+            pbcHz_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+        }
+        // If there is an Ez field set up all TM functions otherwise set them to do nothing
+        if(Ez_)
+        {
+            //initialize the PMLs
+            if(magMatInPML_)
+            {
+                HxPML_   = std::make_shared<CPML>(gridComm_, weights_, Bx_, Ey_, Ez_, POLARIZATION::HX, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Hx_, objArr_);
+                HyPML_   = std::make_shared<CPML>(gridComm_, weights_, By_, Ez_, Ex_, POLARIZATION::HY, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Hy_, objArr_);
+            }
+            else
+            {
+                HxPML_   = std::make_shared<CPML>(gridComm_, weights_, Hx_, Ey_, Ez_, POLARIZATION::HX, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Hx_, objArr_);
+                HyPML_   = std::make_shared<CPML>(gridComm_, weights_, Hy_, Ez_, Ex_, POLARIZATION::HY, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Hy_, objArr_);
+            }
+            if(dielectricMatInPML_)
+            {
+                EzPML_   = std::make_shared<CPML>(gridComm_, weights_, Dz_, Hx_, Hy_, POLARIZATION::EZ, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Ez_, objArr_);
+            }
+            else
+            {
+                EzPML_   = std::make_shared<CPML>(gridComm_, weights_, Ez_, Hx_, Hy_, POLARIZATION::EZ, pmlThickness_, IP.pmlM_, IP.pmlMa_, IP.pmlAMax_, d_, dt_, phys_Ez_, objArr_);
+            }
+            // Fill update lists
+            initializeList(phys_Ez_, EzPML_,  true, std::array<int,3>( {{-1,  0,  0 }} ), std::array<int,3>( {{n_vec_[0]+1, n_vec_[1]+1, n_vec_[2]   }} ), d_[0], upEz_, upDz_);
+            initializeList(phys_Hx_, HxPML_, false, std::array<int,3>( {{ 0,  1,  0 }} ), std::array<int,3>( {{n_vec_[0]+1, n_vec_[1]  , n_vec_[2]   }} ), d_[1], upHx_, upBx_);
+            initializeList(phys_Hy_, HyPML_, false, std::array<int,3>( {{ 0,  0,  1 }} ), std::array<int,3>( {{n_vec_[0]  , n_vec_[1]+1, n_vec_[2]   }} ), d_[0], upHy_, upBy_);
+
+            updateHxPML_ = [](pml_ptr pml){pml->updateGrid();};
+            updateHyPML_ = [](pml_ptr pml){pml->updateGrid();};
+            updateEzPML_ = [](pml_ptr pml){pml->updateGrid();};
+
+            if(IP.periodic_ && gridComm_->size() > 1)
+            {
+                yHxPBC_ = ln_vec_[1]+1;
+                yHyPBC_ = ln_vec_[1]+1;
+                yEzPBC_ = ln_vec_[1]+1;
+                //Field definition buffer
+                if(gridComm_->npY()-1 == gridComm_->mypY())
+                    yHxPBC_ = ln_vec_[1];
+            }
+            else if(IP.periodic_)
+            {
+                yHxPBC_ = ln_vec_[1];
+                yHyPBC_ = ln_vec_[1]+1;
+                yEzPBC_ = ln_vec_[1]+1;
+            }
+            else
+            {
+                pbcHx_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+                pbcHy_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+                pbcEz_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+            }
+
+            // Add the fields to the halo exchanges, they should do nothing if only on one processor
+            if(gridComm_->size() > 1)
+            {
+                transferH_->addGrid(Hx_);
+                transferH_->addGrid(Hy_);
+                transferE_->addGrid(Ez_);
+            }
+        }
+        else
+        {
+            upHxFxn_ = [](std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr){return;};;
+            upHyFxn_ = [](std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr){return;};
+
+            upEzFxn_ = [](std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr){return;};
+
+            upLorMxFxn_ = []( std::array<int,8>&, pgrid_ptr, std::vector<pgrid_ptr>&, std::vector<pgrid_ptr>&, T*, std::shared_ptr<Obj> ){return;};
+            upLorMyFxn_ = []( std::array<int,8>&, pgrid_ptr, std::vector<pgrid_ptr>&, std::vector<pgrid_ptr>&, T*, std::shared_ptr<Obj> ){return;};
+            upLorPzFxn_ = []( std::array<int,8>&, pgrid_ptr, std::vector<pgrid_ptr>&, std::vector<pgrid_ptr>&, T*, std::shared_ptr<Obj> ){return;};
+
+            B2HxFxn_ = []( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj> ){return;};
+            B2HyFxn_ = []( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj> ){return;};
+            D2EzFxn_ = []( std::array<int,8>&, pgrid_ptr, pgrid_ptr, std::vector<pgrid_ptr>&, std::shared_ptr<Obj> ){return;};
+
+            updateHxPML_ = [](pml_ptr pml){return;};
+            updateHyPML_ = [](pml_ptr pml){return;};
+            updateEzPML_ = [](pml_ptr pml){return;};
+
+            pbcHx_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+            pbcHy_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+            pbcEz_ = [](pgrid_ptr, std::array<double,3>&, int, int, int, int, int, int, int, double&, double&, double&){return;};
+        }
+        // All update lists are filled, split them up between the threads
+        setupThreadBounds();
+        setupCurlPlans(IP);
+        // Construct all soft sources
+        for(int ss = 0; ss < IP.srcPol_.size(); ss++)
+        {
+            // Make the pulse (including all pulses to be used)
+            std::vector<std::shared_ptr<PulseBase>> pul;
+            for(int pp = 0; pp < IP.srcPulShape_[ss].size(); pp ++)
+            {
+                if(IP.srcPulShape_[ss][pp] == PLSSHAPE::CONTINUOUS)
+                    pul.push_back(std::make_shared<PulseCont>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp], dt_));
+                else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::BH)
+                    pul.push_back(std::make_shared<PulseBH>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp], dt_));
+                else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::RECT)
+                    pul.push_back(std::make_shared<PulseRect>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp], dt_));
+                else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::GAUSSIAN)
+                    pul.push_back(std::make_shared<PulseGauss>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp], dt_));
+                else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::RICKER)
+                    pul.push_back(std::make_shared<PulseRicker>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp], dt_));
+                else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::RAMP_CONT)
+                    pul.push_back(std::make_shared<PulseRampCont>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp], dt_));
+            }
+            //  Make the source act on any of the fields
+            if(IP.srcPol_[ss] == POLARIZATION::EX)
+            {
+                if(int( round(IP.srcPhi_[ss]) ) % 90 == 0)
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Ex_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                else
+                {
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Ex_, POLARIZATION::EX, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Ey_, POLARIZATION::EY, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                }
+            }
+            else if(IP.srcPol_[ss] == POLARIZATION::EY)
+            {
+                if(int( round(IP.srcPhi_[ss]) ) % 90 == 0)
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Ey_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                else
+                {
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Ex_, POLARIZATION::EX, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Ey_, POLARIZATION::EY, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                }
+            }
+            else if(IP.srcPol_[ss] == POLARIZATION::EZ)
+            {
+                if(int( round(IP.srcPhi_[ss]) ) % 90 == 0)
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Ez_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                else
+                {
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Ez_, POLARIZATION::EZ, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                }
+            }
+            else if(IP.srcPol_[ss] == POLARIZATION::HX)
+            {
+                if(int( round(IP.srcPhi_[ss]) ) % 90 == 0)
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Hx_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                else
+                {
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Hy_, POLARIZATION::HY, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Hx_, POLARIZATION::HX, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                }
+            }
+            else if(IP.srcPol_[ss] == POLARIZATION::HY)
+            {
+                if(int( round(IP.srcPhi_[ss]) ) % 90 == 0)
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Hy_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                else
+                {
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Hx_, POLARIZATION::HX, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Hy_, POLARIZATION::HY, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                }
+            }
+            else if(IP.srcPol_[ss] == POLARIZATION::HZ)
+            {
+                if(int( round(IP.srcPhi_[ss]) ) % 90 == 0)
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Hz_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                else
+                {
+                    srcArr_.push_back( std::make_shared<SRCOBLIQUE>(gridComm_, pul, Hz_, POLARIZATION::HZ, dt_, IP.srcLoc_[ss], IP.srcSz_[ss], IP.srcPhi_[ss], IP.srcTheta_[ss] ) );
+                }
+            }
+            else
+            {
+                double axRat = IP.srcEllipticalKratio_[ss];
+                double psi = IP.srcPsi_[ss];
+                double psiPrefactCalc = psi;
+                double alphaOff = 0.0;
+                double prefactor_k_ = 1.0;
+                double prefactor_j_ = 1.0;
+                double c = pow(axRat, 2.0);
+
+                // phi/psi control the light polarization angle
+                psiPrefactCalc = 0.5 * asin( sqrt( ( pow(cos(2.0*psi),2.0)*4.0*c + pow( (1.0+c)*sin(2.0*psi), 2.0) ) / pow(1.0+c, 2.0) ) );
+                alphaOff = acos( ( (c - 1.0)*sin(2.0*psi) ) / sqrt( pow(cos(2.0*psi),2.0)*4.0*c + pow( (1.0+c)*sin(2.0*psi), 2.0) ) );
+                if(std::abs( std::tan(psi) ) > 1)
+                    psiPrefactCalc = M_PI/2.0 - psiPrefactCalc;
+                if(IP.srcPol_[ss] == POLARIZATION::R)
+                    alphaOff *= -1.0;
+
+                if( isamin_(IP.srcSz_[ss].size(), IP.srcSz_[ss].data(), 1)-1 == 0 )
+                {
+                    prefactor_j_ *= -1.0 * cos(psiPrefactCalc);
+                    prefactor_k_ *= -1.0 * sin(psiPrefactCalc);
+                }
+                else if( isamin_(IP.srcSz_[ss].size(), IP.srcSz_[ss].data(), 1)-1 == 1 )
+                {
+                    prefactor_j_ *=  -1.0 * cos(psiPrefactCalc);
+                    prefactor_k_ *=         sin(psiPrefactCalc);
+                }
+                else if( isamin_(IP.srcSz_[ss].size(), IP.srcSz_[ss].data(), 1)-1 == 2 )
+                {
+                    prefactor_j_ *= -1.0*sin(psiPrefactCalc);
+                    prefactor_k_ *=      cos(psiPrefactCalc);
+                }
+
+                for(auto pulse : pul)
+                    pulse->modE0(prefactor_j_);
+                std::vector<std::shared_ptr<PulseBase>> phaseOffPul;
+                for(int pp = 0; pp < IP.srcPulShape_[ss].size(); pp ++)
+                {
+                    if(IP.srcPulShape_[ss][pp] == PLSSHAPE::CONTINUOUS)
+                        phaseOffPul.push_back(std::make_shared<PulseCont>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp]*prefactor_k_, dt_, alphaOff));
+                    else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::BH)
+                        phaseOffPul.push_back(std::make_shared<PulseBH>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp]*prefactor_k_, dt_, alphaOff));
+                    else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::RECT)
+                        phaseOffPul.push_back(std::make_shared<PulseRect>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp]*prefactor_k_, dt_, alphaOff));
+                    else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::GAUSSIAN)
+                        phaseOffPul.push_back(std::make_shared<PulseGauss>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp]*prefactor_k_, dt_, alphaOff));
+                    else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::RICKER)
+                        phaseOffPul.push_back(std::make_shared<PulseRicker>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp]*prefactor_k_, dt_, alphaOff));
+                    else if(IP.srcPulShape_[ss][pp] == PLSSHAPE::RAMP_CONT)
+                        phaseOffPul.push_back(std::make_shared<PulseRampCont>(IP.srcFxn_[ss][pp], IP.srcEmax_[ss][pp]*prefactor_k_, dt_, alphaOff));
+                }
+                if(isamin_(IP.srcSz_[ss].size(), IP.srcSz_[ss].data(), 1)-1 == 0 )
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Ey_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, phaseOffPul, Ez_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                if(isamin_(IP.srcSz_[ss].size(), IP.srcSz_[ss].data(), 1)-1 == 1 )
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Ex_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, phaseOffPul, Ez_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+                if(isamin_(IP.srcSz_[ss].size(), IP.srcSz_[ss].data(), 1)-1 == 2 )
+                {
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, pul, Ex_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                    srcArr_.push_back( std::make_shared<SRCNORMAL>(gridComm_, phaseOffPul, Ey_, dt_, IP.srcLoc_[ss], IP.srcSz_[ss] ) );
+                }
+            }
+        }
+
+        // Construct all TFSF surfaces
+        for(int tt = 0; tt < IP.tfsfSize_.size(); tt++)
+        {
+            if(IP.tfsfSize_[tt][0] != 0.0 || IP.tfsfSize_[tt][1] != 0.0)
+            {
+            // Make the pulse (including all pulses to be used)
+                std::vector<std::shared_ptr<PulseBase>> pul;
+                for(int pp = 0; pp < IP.tfsfPulShape_[tt].size(); pp ++)
+                {
+                    if(IP.tfsfPulShape_[tt][pp] == PLSSHAPE::CONTINUOUS)
+                        pul.push_back(std::make_shared<PulseCont>(IP.tfsfPulFxn_[tt][pp], IP.tfsfEmax_[tt][pp], dt_));
+                    else if(IP.tfsfPulShape_[tt][pp] == PLSSHAPE::BH)
+                        pul.push_back(std::make_shared<PulseBH>(IP.tfsfPulFxn_[tt][pp], IP.tfsfEmax_[tt][pp], dt_));
+                    else if(IP.tfsfPulShape_[tt][pp] == PLSSHAPE::RECT)
+                        pul.push_back(std::make_shared<PulseRect>(IP.tfsfPulFxn_[tt][pp], IP.tfsfEmax_[tt][pp], dt_));
+                    else if(IP.tfsfPulShape_[tt][pp] == PLSSHAPE::GAUSSIAN)
+                        pul.push_back(std::make_shared<PulseGauss>(IP.tfsfPulFxn_[tt][pp], IP.tfsfEmax_[tt][pp], dt_));
+                    else if(IP.tfsfPulShape_[tt][pp] == PLSSHAPE::RICKER)
+                        pul.push_back(std::make_shared<PulseRicker>(IP.tfsfPulFxn_[tt][pp], IP.tfsfEmax_[tt][pp], dt_));
+                    else if(IP.tfsfPulShape_[tt][pp] == PLSSHAPE::RAMP_CONT)
+                        pul.push_back(std::make_shared<PulseRampCont>(IP.tfsfPulFxn_[tt][pp], IP.tfsfEmax_[tt][pp], dt_));
+                }
+                // TFSF will determine the correct polarization
+                tfsfArr_.push_back(std::make_shared<TFSF>(gridComm_, IP.tfsfLoc_[tt], IP.tfsfSize_[tt], IP.tfsfTheta_[tt], IP.tfsfPhi_[tt], IP.tfsfPsi_[tt], IP.tfsfCircPol_[tt], IP.tfsfEllipticalKratio_[tt], d_[0], dt_, pul, Ex_, Ey_, Ez_, Hx_, Hy_, Hz_) );
+                if(IP.tfsfTable_)
+                    tfsfArr_.back()->precomputeTable(static_cast<int>(std::ceil(IP.tMax_ / dt_) ), IP.tfsfTableCache_);
+            }
+        }
+        // Polarization matters here since the z field always forms the continous box for the spatial offset (TE uses H, TM uses E)
+        if(IP.fluxName_.size() > 0)
+        {
+            DIRECTION propDir;
+            if(tfsfArr_.size() > 0 && (tfsfArr_.back()->theta() == 0.0 || tfsfArr_.back()->theta() == M_PI ) )
+                propDir = DIRECTION::Z;
+            else if(tfsfArr_.size() > 0 && (tfsfArr_.back()->quadrant() == 2 || tfsfArr_.back()->quadrant() == 4 ) )
+                propDir = DIRECTION::X;
+            else if(tfsfArr_.size() > 0 && (tfsfArr_.back()->quadrant() == 1 || tfsfArr_.back()->quadrant() == 3 ) )
+                propDir = DIRECTION::Y;
+            else if(srcArr_.size() > 0 && (srcArr_.back()->sz()[0] >= srcArr_.back()->sz()[1] ) && (srcArr_.back()->sz()[2] >= srcArr_.back()->sz()[1] ) )
+                propDir = DIRECTION::Y;
+            else if(srcArr_.size() > 0 && (srcArr_.back()->sz()[0] <= srcArr_.back()->sz()[1] ) && (srcArr_.back()->sz()[0] <= srcArr_.back()->sz()[2] ) )
+                propDir = DIRECTION::X;
+            else if(srcArr_.size() > 0)
+                propDir = DIRECTION::Z;
+            else
+                throw std::logic_error("Constructing a flux with no source, it will be 0.");
+
+            double theta = 0; double phi = 0; double psi = 0; double alpha = 0;
+            if(tfsfArr_.size() > 0)
+            {
+                theta = std::atan( std::abs( std::tan( tfsfArr_.back()->theta() ) ) );
+                phi   = std::atan( std::abs( std::tan( tfsfArr_.back()->phiPreFact() ) ) );
+                psi   = std::atan( std::abs( std::tan( tfsfArr_.back()->psiPreFact() ) ) );
+                alpha = tfsfArr_.back()->alpha();
+            }
+            for(int ff = 0; ff < IP.fluxLoc_.size(); ff ++)
+                fluxArr_.push_back(std::make_shared<FLUX>(gridComm_, IP.fluxName_[ff], IP.fluxWeight_[ff], Ex_, Ey_, Ez_, Hx_, Hy_, Hz_, IP.fluxLoc_[ff], IP.fluxSz_[ff], IP.fluxCrossSec_[ff], IP.fluxSave_[ff], IP.fluxLoad_[ff], IP.fluxTimeInt_[ff], IP.fluxFreqList_[ff], propDir, d_, dt_, theta, phi, psi, alpha, IP.fluxIncdFieldsFilename_[ff], IP.fluxSI_[ff], IP.I0_, IP.a_) );
+        }
+        // Construct all DTC based on types (all it changes is the list of fields it passes)
+        for(int dd = 0; dd < IP.dtcType_.size(); dd++)
+        {
+            std::vector<pgrid_ptr> fields;
+            // Fill the fields vector with the appropriate field values
+            if(IP.dtcType_[dd] == DTCTYPE::EX)
+                fields = {{ Ex_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::EY)
+                fields = {{ Ey_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::EZ)
+                fields = {{ Ez_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::HX)
+                fields = {{ Hx_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::HY)
+                fields = {{ Hy_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::HZ)
+                fields = {{ Hz_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::PX)
+                fields = lorPx_;
+            else if(IP.dtcType_[dd] == DTCTYPE::PY)
+                fields = lorPy_;
+            else if(IP.dtcType_[dd] == DTCTYPE::PZ)
+                fields = lorPz_;
+            else if(IP.dtcType_[dd] == DTCTYPE::MX)
+                fields = lorMx_;
+            else if(IP.dtcType_[dd] == DTCTYPE::MY)
+                fields = lorMy_;
+            else if(IP.dtcType_[dd] == DTCTYPE::MZ)
+                fields = lorMz_;
+            else if(IP.dtcType_[dd] == DTCTYPE::EPOW && Hz_ && Ez_)
+                fields = {{ Ex_, Ey_, Ez_}};
+            else if(IP.dtcType_[dd] == DTCTYPE::HPOW && Hz_ && Ez_)
+                fields = {{ Hx_, Hy_, Hz_}};
+            else if(IP.dtcType_[dd] == DTCTYPE::EPOW && Hz_)
+                fields = {{ Ex_,Ey_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::HPOW && Hz_)
+                fields = {{ Hz_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::EPOW && Ez_)
+                fields = {{ Ez_ }};
+            else if(IP.dtcType_[dd] == DTCTYPE::HPOW && Ez_)
+                fields = {{ Hx_,Hy_ }};
+            else
+                throw std::logic_error("DTC TYPE IS NOT DEFINED");
+            coustructDTC(IP.dtcClass_[dd], fields, IP.dtcSI_[dd], IP.dtcLoc_[dd], IP.dtcSz_[dd], IP.dtcName_[dd], IP.dtcOutBMPFxnType_[dd], IP.dtcOutBMPOutType_[dd], IP.dtcType_[dd], IP.dtcFreqList_[dd], IP.dtcTimeInt_[dd], IP.a_, IP.I0_, IP.tMax_);
+        }
+        // Sources are now placed so the slabs for the temporally blocked update can be set up
+        setupTiling(IP);
+        // Initialze all detectors to time 0 (a continued run takes the detector state from the propagator it replaces)
+        if(!resumeOutput_)
+        {
+            for(auto& dtc : dtcArr_)
+                dtc->output(tcur_);
+            for(auto& dtc : dtcFreqArr_)
+                dtc->output(tcur_);
+            for(auto& flux : fluxArr_)
+                flux->fieldIn(tcur_);
+        }
+
+        E_incd_.push_back(0.0);
+        E_pl_incd_.push_back(0.0);
+        H_incd_.push_back(0.0);
+        H_mn_incd_.push_back(0.0);
+    }
+
     /**
      * @brief      Constructs a DTC based off of the input parameters and puts it in the proper detector vector
      *
@@ -617,6 +1399,37 @@ public:
         return std::make_tuple(upULists, upDLists);
     }
 
+    /**
+     * @brief      Restricts a D or B grid to the local y rows with cells in dispersive (or magnetic) objects, all rows are kept if such material reaches into the PMLs since the PMLs then update the grid everywhere in their slabs
+     *
+     * @param      grid      The D or B grid (nothing is done for a nullptr)
+     * @param[in]  physGrid  The object map of the matching E or H field
+     * @param[in]  E         True if grid is a D grid
+     */
+    void restrictAuxRows(pgrid_ptr grid, std::shared_ptr<parallelGrid<int>> physGrid, bool E)
+    {
+        if(!grid || (E && dielectricMatInPML_) || (!E && magMatInPML_) )
+            return;
+        int rowSz = physGrid->local_x() * physGrid->local_z();
+        int yStart = physGrid->local_y();
+        int yEnd = 0;
+        // The border and process boundary cells of the object map are -1 and have no object
+        for(int yy = 0; yy < physGrid->local_y(); ++yy)
+        {
+            const int* objRow = physGrid->data() + yy*rowSz;
+            if(std::any_of(objRow, objRow + rowSz, [&](int oo){return oo >= 0 && (E ? objArr_[oo]->mat().size() > 1 : objArr_[oo]->magMat().size() > 1);} ) )
+            {
+                yStart = std::min(yStart, yy);
+                yEnd = yy + 1;
+            }
+        }
+        // One extra row on each side keeps the neighbors of the update runs addressable
+        if(yEnd > 0)
+            grid->restrictRows(yStart - 1, yEnd + 1);
+        else
+            grid->restrictRows(0, 0);
+    }
+
     /**
      * @brief      Sets up the object map grids for each field
      *
@@ -690,131 +1503,162 @@ public:
     }
 
     /**
-     * @brief      Sets up the weight grid for dividing processes by taking average of H/E fields and for 3D calcs the flux region calcs
+     * @brief      Sums the weights of every plane normal to the x, y, and z directions used to split the cell between the processes
+     * @details    Each process builds a set of y planes (every nproc-th plane) one at a time and the plane sums are added up over all processes, so the full weight grids are never stored. Objects are only tested at the points inside their bounding boxes. The weight of a point is the cost of the last object holding it, plus the PML and flux surface costs (the flux surfaces are only counted for 3D calcs)
      *
      * @param[in]  IP    Input parameter object that is being used to construct the propagator
      */
     void setupWeightsGrid(const parallelProgramInputs &IP)
     {
-        // test point will move across all grid points
-        // Set weights based off of normal materials, number of axpy calls per time step (6 base + 3*n_lor_pol = 6 + 3*(objArr_[kk]->mat().size()-1)/3)*number of E fields
-        std::array<double,3> pt = {{0,0,0}};
-        weights_.push_back(std::make_shared<Grid<double>>(n_vec_, d_) );
-        weights_.push_back(std::make_shared<Grid<double>>(n_vec_, d_) );
-        weights_.push_back(std::make_shared<Grid<double>>(n_vec_, d_) );
+        const parallelCostModel& costs = IP.costModel_;
+        const int nx = n_vec_[0];
+        const int ny = n_vec_[1];
+        const int nz = n_vec_[2];
+        for(int dd = 0; dd < 3; ++dd)
+            weights_[dd].assign(n_vec_[dd], 0.0);
+
+        // Grid point ranges of the object bounding boxes, padded by a point to cover the half step offsets of the fields
+        std::vector<std::array<int,6>> objBox(objArr_.size());
+        // Cost of the curl plus the cost of each Lorentz pole of the object (the material vectors store 3 parameters per pole after the infinite frequency value)
+        std::vector<double> objWeight(objArr_.size(), 0.0);
         for(int oo = 0; oo < objArr_.size(); ++oo)
         {
-            for(int ii = 0; ii < n_vec_[0]; ++ii)
+            std::array<std::array<double,3>,2> box = objArr_[oo]->boundBox();
+            for(int dd = 0; dd < 3; ++dd)
+            {
+                double cen = (n_vec_[dd]-1)/2.0;
+                objBox[oo][2*dd  ] = static_cast<int>( std::min(static_cast<double>(n_vec_[dd]), std::max(0.0, std::floor(box[0][dd]/d_[dd] + cen) - 1.0) ) );
+                objBox[oo][2*dd+1] = static_cast<int>( std::max(-1.0, std::min(n_vec_[dd]-1.0, std::ceil(box[1][dd]/d_[dd] + cen) + 1.0) ) );
+            }
+            objWeight[oo] = costs.curl() + costs.pole() * static_cast<double>( (objArr_[oo]->mat().size()-1)/3 + (objArr_[oo]->magMat().size()-1)/3 );
+        }
+        // Number of PML layers a point is in along a direction (the layers on both sides are counted if they overlap)
+        auto nPML = [](int ind, int n, int thick){ return static_cast<double>( (ind < thick) + (n-1-ind < thick) ); };
+
+        // The Ex, Ey, and Ez weights of the current y plane
+        std::array<std::vector<double>,3> plane;
+        for(auto& pl : plane)
+            pl.resize(nx*nz);
+        std::array<double,3> pt = {{0,0,0}};
+        for(int jj = gridComm_->rank(); jj < ny; jj += gridComm_->size())
+        {
+            for(auto& pl : plane)
+                std::fill(pl.begin(), pl.end(), 0.0);
+            for(int oo = 0; oo < objArr_.size(); ++oo)
             {
-                for(int jj = 0; jj < n_vec_[1]; ++jj)
+                if(jj < objBox[oo][2] || jj > objBox[oo][3])
+                    continue;
+                for(int kk = objBox[oo][4]; kk <= objBox[oo][5]; ++kk)
                 {
-                    for(int kk = 0; kk < n_vec_[2]; ++kk)
+                    for(int ii = objBox[oo][0]; ii <= objBox[oo][1]; ++ii)
                     {
                         // Ex points located at ii+1/2, jj
-                        pt[0] = (ii-(n_vec_[0]-1)/2.0+0.5)*d_[0];
-                        pt[1] = (jj-(n_vec_[1]-1)/2.0    )*d_[1];
-                        pt[2] = (kk-(n_vec_[2]-1)/2.0    )*d_[2];
+                        pt[0] = (ii-(nx-1)/2.0+0.5)*d_[0];
+                        pt[1] = (jj-(ny-1)/2.0    )*d_[1];
+                        pt[2] = (kk-(nz-1)/2.0    )*d_[2];
                         if(objArr_[oo]->isObj(pt,d_[0]))
-                            weights_[0]->point(ii,jj,kk) =  (2.0 + (2.0666666666666*static_cast<double>(objArr_[oo]->mat().size()-1) + 2.0666666666666*static_cast<double>(objArr_[oo]->magMat().size()-1) )/2.0 ) ;
+                            plane[0][kk*nx+ii] = objWeight[oo];
                         // Ey points located ii, jj+1/2
                         pt[1] += 0.5*d_[1];
                         pt[0] -= 0.5*d_[0];
                         if(objArr_[oo]->isObj(pt,d_[0]))
-                            weights_[1]->point(ii,jj,kk) =  (2.0 + (2.0666666666666*static_cast<double>(objArr_[oo]->mat().size()-1) + 2.0666666666666*static_cast<double>(objArr_[oo]->magMat().size()-1) )/2.0 ) ;
+                            plane[1][kk*nx+ii] = objWeight[oo];
                         // Ez point is at ii, jj
                         pt[1] -= 0.5*d_[1];
                         pt[2] += 0.5*d_[2];
                         if(objArr_[oo]->isObj(pt,d_[0]))
-                            weights_[2]->point(ii,jj,kk) =  (2.0 + (2.0666666666666*static_cast<double>(objArr_[oo]->mat().size()-1) + 2.0666666666666*static_cast<double>(objArr_[oo]->magMat().size()-1) )/2.0 ) ;
+                            plane[2][kk*nx+ii] = objWeight[oo];
                     }
                 }
             }
-        }
-        std::vector<double> copyZero(n_vec_[0]*n_vec_[2], 0.0);
-        // Ey has no points on the ny-1 face
-        std::copy_n( copyZero.data(), n_vec_[0]*n_vec_[2], &weights_[1]->point(0, n_vec_[1]-1, 0) );
-        // Ex has no points on the nx-1 face
-        for(int yy = 0; yy < n_vec_[1]; ++yy)
-            dcopy_(n_vec_[2], copyZero.data(), 1, &weights_[0]->point(n_vec_[0]-1, yy, 0), weights_[0]->x() );
-        // Ez has no points on the nz-1 face
-        for(int yy = 0; yy < n_vec_[1]; ++yy)
-            std::copy_n(copyZero.data(), n_vec_[0], &weights_[2]->point(0, yy, n_vec_[2]-1) );
-        // Add PMLs
-        for(int xx = 0; xx < IP.pmlThickness_[0]; ++xx)
-        {
-            // Ex field has no PML along the left and right
-            for(int yy = 0; yy < weights_[0]->y(); ++ yy)
+            // Ex has no points on the nx-1 face, Ey has no points on the ny-1 face, and Ez has no points on the nz-1 face
+            for(int kk = 0; kk < nz; ++kk)
+                plane[0][kk*nx+nx-1] = 0.0;
+            if(jj == ny-1)
+                std::fill(plane[1].begin(), plane[1].end(), 0.0);
+            std::fill_n(&plane[2][(nz-1)*nx], nx, 0.0);
+
+            // Add PMLs: Ex field has no PML along the left and right, Ey has none along the top and bottom, and Ez has none along the front and back
+            for(int ii = 0; ii < nx; ++ii)
             {
-                daxpy_(weights_[1]->z(), 1.0, std::vector<double>(n_vec_[2], 3.1).data(), 1, &weights_[1]->point(            xx, yy, 0), weights_[1]->x());
-                daxpy_(weights_[2]->z(), 1.0, std::vector<double>(n_vec_[2], 3.1).data(), 1, &weights_[2]->point(            xx, yy, 0), weights_[2]->x());
-
-                daxpy_(weights_[1]->z(), 1.0, std::vector<double>(n_vec_[2], 3.1).data(), 1, &weights_[1]->point(n_vec_[0]-1-xx, yy, 0), weights_[1]->x());
-                daxpy_(weights_[2]->z(), 1.0, std::vector<double>(n_vec_[2], 3.1).data(), 1, &weights_[2]->point(n_vec_[0]-1-xx, yy, 0), weights_[2]->x());
+                double pmlWeight = costs.pml() * nPML(ii, nx, IP.pmlThickness_[0]);
+                for(int kk = 0; kk < nz && pmlWeight > 0.0; ++kk)
+                {
+                    plane[1][kk*nx+ii] += pmlWeight;
+                    plane[2][kk*nx+ii] += pmlWeight;
+                }
             }
-        }
-        std::fill_n(copyZero.begin(), copyZero.size(), 3.1);
-        for(int yy = 0; yy < IP.pmlThickness_[1]; ++yy)
-        {
-            // Ey field has no PML along the top and bottom
-            std::transform(copyZero.begin(), copyZero.end(), &weights_[0]->point(0,             yy, 0), &weights_[0]->point(0,             yy, 0), [](double a, double b){return a+b;});
-            std::transform(copyZero.begin(), copyZero.end(), &weights_[2]->point(0,             yy, 0), &weights_[2]->point(0,             yy, 0), [](double a, double b){return a+b;});
-
-            std::transform(copyZero.begin(), copyZero.end(), &weights_[0]->point(0, n_vec_[1]-1-yy, 0), &weights_[0]->point(0, n_vec_[1]-1-yy, 0), [](double a, double b){return a+b;});
-            std::transform(copyZero.begin(), copyZero.end(), &weights_[2]->point(0, n_vec_[1]-1-yy, 0), &weights_[2]->point(0, n_vec_[1]-1-yy, 0), [](double a, double b){return a+b;});
-        }
-        if(IP.size_[2] > 0)
-        {
-            for(int zz = 0; zz < IP.pmlThickness_[2]; ++zz)
+            double yPMLWeight = costs.pml() * nPML(jj, ny, IP.pmlThickness_[1]);
+            for(int pp = 0; pp < nx*nz && yPMLWeight > 0.0; ++pp)
+            {
+                plane[0][pp] += yPMLWeight;
+                plane[2][pp] += yPMLWeight;
+            }
+            if(IP.size_[2] > 0)
             {
-                // Ez field has no PML along the front/back
-                for(int yy = 0; yy < weights_[0]->y(); ++ yy)
+                for(int kk = 0; kk < nz; ++kk)
                 {
-                    std::transform(copyZero.begin(), copyZero.begin()+weights_[0]->x(), &weights_[0]->point(0, yy,             zz), &weights_[0]->point(0, yy,             zz), [](double a, double b){return a+b;});
-                    std::transform(copyZero.begin(), copyZero.begin()+weights_[1]->x(), &weights_[1]->point(0, yy,             zz), &weights_[1]->point(0, yy,             zz), [](double a, double b){return a+b;});
-
-                    std::transform(copyZero.begin(), copyZero.begin()+weights_[0]->x(), &weights_[0]->point(0, yy, n_vec_[2]-1-zz), &weights_[0]->point(0, yy, n_vec_[2]-1-zz), [](double a, double b){return a+b;});
-                    std::transform(copyZero.begin(), copyZero.begin()+weights_[1]->x(), &weights_[1]->point(0, yy, n_vec_[2]-1-zz), &weights_[1]->point(0, yy, n_vec_[2]-1-zz), [](double a, double b){return a+b;});
-
+                    double pmlWeight = costs.pml() * nPML(kk, nz, IP.pmlThickness_[2]);
+                    for(int ii = 0; ii < nx && pmlWeight > 0.0; ++ii)
+                    {
+                        plane[0][kk*nx+ii] += pmlWeight;
+                        plane[1][kk*nx+ii] += pmlWeight;
+                    }
                 }
             }
-        }
-        // Computational cost of flux for 2D calcs is small so it is neglected.
-        if(IP.size_[2] > 0)
-        {
-            // Include weights for flux regions
-            for(int ff = 0; ff < IP.fluxLoc_.size(); ++ff)
+
+            // Computational cost of flux for 2D calcs is small so it is neglected.
+            if(IP.size_[2] > 0)
             {
-                std::vector<double> fluxWeight( std::max( std::max(n_vec_[0], n_vec_[1]), n_vec_[2] ), IP.fluxFreqList_[ff].size() );
-                for(int yy = 0; yy < IP.fluxSz_[ff][1]; ++yy)
+                for(int ff = 0; ff < IP.fluxLoc_.size(); ++ff)
                 {
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[0]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[1]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[2]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), 1);
-
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[0]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]+IP.fluxSz_[ff][2]-1), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[1]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]+IP.fluxSz_[ff][2]-1), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[2]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]+IP.fluxSz_[ff][2]-1), 1);
-
-                    daxpy_(IP.fluxSz_[ff][2], 1.0, fluxWeight.data(), 1, &weights_[0]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), 1);
-                    daxpy_(IP.fluxSz_[ff][2], 1.0, fluxWeight.data(), 1, &weights_[1]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), 1);
-                    daxpy_(IP.fluxSz_[ff][2], 1.0, fluxWeight.data(), 1, &weights_[2]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), 1);
-
-                    daxpy_(IP.fluxSz_[ff][2], 1.0, fluxWeight.data(), 1, &weights_[0]->point(IP.fluxLoc_[ff][0]+IP.fluxSz_[ff][0]-1, IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), weights_[0]->x());
-                    daxpy_(IP.fluxSz_[ff][2], 1.0, fluxWeight.data(), 1, &weights_[1]->point(IP.fluxLoc_[ff][0]+IP.fluxSz_[ff][0]-1, IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), weights_[1]->x());
-                    daxpy_(IP.fluxSz_[ff][2], 1.0, fluxWeight.data(), 1, &weights_[2]->point(IP.fluxLoc_[ff][0]+IP.fluxSz_[ff][0]-1, IP.fluxLoc_[ff][1]+yy, IP.fluxLoc_[ff][2]), weights_[2]->x());
+                    const std::array<int,3>& loc = IP.fluxLoc_[ff];
+                    const std::array<int,3>& sz  = IP.fluxSz_[ff];
+                    double fluxWeight = costs.dft() * IP.fluxFreqList_[ff].size();
+                    for(auto& pl : plane)
+                    {
+                        // Edges of the flux box parallel to x and z in the planes it crosses
+                        if(jj >= loc[1] && jj < loc[1]+sz[1])
+                        {
+                            for(int ii = loc[0]; ii < loc[0]+sz[0]; ++ii)
+                            {
+                                pl[ loc[2]         *nx+ii] += fluxWeight;
+                                pl[(loc[2]+sz[2]-1)*nx+ii] += fluxWeight;
+                            }
+                            for(int kk = loc[2]; kk < loc[2]+sz[2]; ++kk)
+                            {
+                                pl[kk*nx+loc[0]        ] += fluxWeight;
+                                pl[kk*nx+loc[0]+sz[0]-1] += fluxWeight;
+                            }
+                        }
+                        // Faces of the flux box normal to y
+                        int nFace = (jj == loc[1]) + (jj == loc[1]+sz[1]-1);
+                        for(int kk = loc[2]; kk < loc[2]+sz[2] && nFace > 0; ++kk)
+                            for(int ii = loc[0]; ii < loc[0]+sz[0]; ++ii)
+                                pl[kk*nx+ii] += nFace * fluxWeight;
+                    }
                 }
-                for(int zz = 0; zz < IP.fluxSz_[ff][2]; ++zz)
-                {
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[0]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1], IP.fluxLoc_[ff][2]+zz), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[1]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1], IP.fluxLoc_[ff][2]+zz), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[2]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1], IP.fluxLoc_[ff][2]+zz), 1);
+            }
 
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[0]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+IP.fluxSz_[ff][1]-1, IP.fluxLoc_[ff][2]+zz), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[1]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+IP.fluxSz_[ff][1]-1, IP.fluxLoc_[ff][2]+zz), 1);
-                    daxpy_(IP.fluxSz_[ff][0], 1.0, fluxWeight.data(), 1, &weights_[2]->point(IP.fluxLoc_[ff][0], IP.fluxLoc_[ff][1]+IP.fluxSz_[ff][1]-1, IP.fluxLoc_[ff][2]+zz), 1);
+            for(auto& pl : plane)
+            {
+                for(int kk = 0; kk < nz; ++kk)
+                {
+                    for(int ii = 0; ii < nx; ++ii)
+                    {
+                        weights_[0][ii] += pl[kk*nx+ii];
+                        weights_[1][jj] += pl[kk*nx+ii];
+                        weights_[2][kk] += pl[kk*nx+ii];
+                    }
                 }
             }
         }
+        // Every y plane was built by exactly one process
+        for(auto& w : weights_)
+        {
+            std::vector<double> localSum(w);
+            mpi::all_reduce(*gridComm_, localSum.data(), static_cast<int>(localSum.size() ), w.data(), std::plus<double>() );
+        }
     }
     /**
      * @brief return the current time
@@ -824,12 +1668,22 @@ public:
 
     /**
      * @brief      steps the propagator forward one unit in time
+     * @details    The halo transfers are overlapped with the updates that do not need them: each field's transfer is started once it is fully updated and finished just before the points next to the transfer regions are updated
      */
     void step()
     {
-        // Update H/B fields
-        updateH();
-        updateB();
+        // Update the H/B points that do not need the E transfer regions while the E transfer from the last step finishes
+        if(progress_)
+            progress_->resume();
+        updateH(false);
+        updateB(false);
+        if(progress_)
+            progress_->pause();
+
+        transferE_->finish();
+
+        updateH(true);
+        updateB(true);
 
         // Include PML updates before transferring from B to H
         updateHxPML_(HxPML_);
@@ -856,13 +1710,20 @@ public:
         pbcHy_(Hy_, k_point_, ln_vec_[0]+1, ln_vec_[1]+1, pbcZMax_+1, ln_vec_[0]  , yHyPBC_, pbcZMin_, pbcZMax_  , d_[0], d_[1], d_[2] );
         pbcHz_(Hz_, k_point_, ln_vec_[0]+1, ln_vec_[1]+1, pbcZMax_+1, ln_vec_[0]  , yHzPBC_, pbcZMin_, pbcZMax_+1, d_[0], d_[1], d_[2] );
 
-        transferHx_();
-        transferHy_();
-        transferHz_();
+        transferH_->start();
 
-        // Update E.D fields
-        updateE();
-        updateD();
+        // Update the E/D points that do not need the H transfer regions while the H transfer is in flight
+        if(progress_)
+            progress_->resume();
+        updateE(false);
+        updateD(false);
+        if(progress_)
+            progress_->pause();
+
+        transferH_->finish();
+
+        updateE(true);
+        updateD(true);
 
         // Include PML updates before transferring from D to E
         updateExPML_(ExPML_);
@@ -877,14 +1738,158 @@ public:
         pbcEy_(Ey_, k_point_, ln_vec_[0]+1, ln_vec_[1]+1, pbcZMax_+1, ln_vec_[0]+1, yEyPBC_, pbcZMin_, pbcZMax_+1, d_[0], d_[1], d_[2]);
         pbcEz_(Ez_, k_point_, ln_vec_[0]+1, ln_vec_[1]+1, pbcZMax_+1, ln_vec_[0]+1, yEzPBC_, pbcZMin_, pbcZMax_  , d_[0], d_[1], d_[2]);
 
-        transferEx_();
-        transferEy_();
-        transferEz_();
+        transferE_->start();
 
         // Increment time steps to before output as all fields should be updated to the next time step now
         tcur_ += dt_;
         ++t_step_;
 
+        outputDetectors();
+    }
+
+    /**
+     * @brief      Advances the propagator up to timeTile_ steps at once with a wavefront in y so each slab stays in cache for all of the steps
+     * @details    The slabs are swept in y and each later time step trails the one before it by two slabs, so every slab only reads neighboring slabs that are already at the right time. Tiles stop at the next detector output so all outputs happen at the same steps as step.
+     *
+     * @param[in]  maxSteps  The maximum number of time steps to advance
+     *
+     * @return     The number of time steps advanced
+     */
+    int stepTile(int maxSteps)
+    {
+        int nSteps = std::min(std::min(maxSteps, timeTile_), stepsToOutput() );
+        if(nSteps <= 1)
+        {
+            step();
+            return 1;
+        }
+        // Accumulate the times the same way step does so the pulses are evaluated at exactly the same times
+        std::vector<double> tLevel(nSteps, tcur_);
+        for(int tau = 1; tau < nSteps; ++tau)
+            tLevel[tau] = tLevel[tau-1] + dt_;
+        // The incident fields of the TFSF surfaces are stepped ahead, keeping the values each step adds to the slabs
+        for(int tau = 0; tau < nSteps; ++tau)
+        {
+            for(auto & tfsf : tfsfArr_)
+            {
+                   H_incd_.push_back(tfsf->   H_incd());
+                H_mn_incd_.push_back(tfsf->H_mn_incd());
+                tfsf->stepTileLevel(tau);
+                   E_incd_.push_back(tfsf->   E_incd());
+                E_pl_incd_.push_back(tfsf->E_pl_incd());
+            }
+        }
+        int nSlabs = tileSlabY_.size() - 1;
+        #pragma omp parallel num_threads(nThreads_)
+        {
+            for(int kk = 0; kk < nSlabs + 2*nSteps - 1; ++kk)
+            {
+                for(int tau = 0; tau < nSteps; ++tau)
+                {
+                    int ss = kk - 2*tau;
+                    if(ss >= 0 && ss < nSlabs)
+                        updateSlab(0, ss, tau, tLevel[tau]);
+                    if(ss-1 >= 0 && ss-1 < nSlabs)
+                        updateSlab(3, ss-1, tau, tLevel[tau]);
+                }
+            }
+        }
+        tcur_ = tLevel.back() + dt_;
+        t_step_ += nSteps;
+        outputDetectors();
+        return nSteps;
+    }
+
+    /**
+     * @brief      Updates one slab of either the H or E fields for stepTile and adds the PMLs, TFSF surfaces, and pulses of the sources inside it, must be called by all threads
+     *
+     * @param[in]  c0    0 to update the H fields and 3 to update the E fields
+     * @param[in]  ss    The slab index
+     * @param[in]  tau   The index of the step inside the blocked update
+     * @param[in]  t     The time of the step the slab is being advanced from
+     */
+    void updateSlab(int c0, int ss, int tau, double t)
+    {
+        std::array<std::function<void( std::array<int,8>&, std::array<double,2>&, pgrid_ptr, pgrid_ptr, pgrid_ptr )>*, 6> upFxn = {{ &upHxFxn_, &upHyFxn_, &upHzFxn_, &upExFxn_, &upEyFxn_, &upEzFxn_ }};
+        std::array<pgrid_ptr,6> fields = {{ Hx_, Hy_, Hz_, Ex_, Ey_, Ez_ }};
+        std::array<pml_ptr,6> pmls = {{ HxPML_, HyPML_, HzPML_, ExPML_, EyPML_, EzPML_ }};
+        // Same order as step: the incident fields and pulses are added to the E fields before they are updated and to the H fields after
+        if(c0 == 3)
+            addSlabPul(ss, tau, t, false);
+        for(int cc = c0; cc < c0+3; ++cc)
+        {
+            // Each field component is independent of the others so only the last one needs to wait for all threads
+            #pragma omp for schedule(static) nowait
+            for(int ii = tileSlabRuns_[cc][ss]; ii < tileSlabRuns_[cc][ss+1]; ++ii)
+                (*upFxn[cc])(std::get<0>(tileUp_[cc][ii]), std::get<1>(tileUp_[cc][ii]), fields[cc], fields[3-c0+(cc-c0+1)%3], fields[3-c0+(cc-c0+2)%3]);
+        }
+        #pragma omp barrier
+        // The PMLs of the three components only write to their own fields
+        #pragma omp for schedule(static)
+        for(int cc = c0; cc < c0+3; ++cc)
+            if(pmls[cc])
+                pmls[cc]->updateSlab(ss);
+        if(c0 == 0)
+            addSlabPul(ss, tau, t, true);
+    }
+
+    /**
+     * @brief      Adds the incident fields of all TFSF surfaces and the pulses of all sources in a slab from the master thread
+     *
+     * @param[in]  ss     The slab index
+     * @param[in]  tau    The index of the step inside the blocked update
+     * @param[in]  t      The current time
+     * @param[in]  hSrcs  If true add to the H fields otherwise to the E fields
+     */
+    void addSlabPul(int ss, int tau, double t, bool hSrcs)
+    {
+        #pragma omp master
+        {
+            for(auto & tfsf : tfsfArr_)
+                tfsf->addSlab(ss, tau, !hSrcs);
+            for(int ii = 0; ii < srcArr_.size(); ++ii)
+            {
+                bool hSrc = srcArr_[ii]->grid() == Hx_ || srcArr_[ii]->grid() == Hy_ || srcArr_[ii]->grid() == Hz_;
+                if(tileSrcSlab_[ii] == ss && hSrc == hSrcs)
+                    srcArr_[ii]->addPul(t);
+            }
+        }
+        #pragma omp barrier
+    }
+
+    /**
+     * @return     The number of time steps until the next step any detector or flux object outputs
+     */
+    int stepsToOutput()
+    {
+        int nSteps = std::numeric_limits<int>::max();
+        for(auto & dtc : dtcArr_)
+            nSteps = std::min(nSteps, dtc->timeInt() - t_step_ % dtc->timeInt() );
+        for(auto & dtc : dtcFreqArr_)
+            nSteps = std::min(nSteps, dtc->timeInt() - t_step_ % dtc->timeInt() );
+        for(auto & flux : fluxArr_)
+            nSteps = std::min(nSteps, flux->timeInt() - t_step_ % flux->timeInt() );
+        return nSteps;
+    }
+
+    /**
+     * @brief      Outputs all detectors and flux objects that output at the current time step
+     */
+    void outputDetectors()
+    {
+        // The E transfer is normally finished during the next H update, detectors need it done now
+        bool outStep = false;
+        for(auto & dtc : dtcArr_)
+            outStep = outStep || (t_step_ % dtc->timeInt() == 0);
+        for(auto & dtc : dtcFreqArr_)
+            outStep = outStep || (t_step_ % dtc->timeInt() == 0);
+        for(auto & flux : fluxArr_)
+            outStep = outStep || (t_step_ % flux->timeInt() == 0);
+        if(outStep)
+            finishTransfers();
+        if(outStep && polOutput_)
+            copyPoleStores(true);
+
         // Output all detector values
         for(auto & dtc : dtcArr_)
             if(t_step_ % dtc->timeInt() == 0)
@@ -898,98 +1903,357 @@ public:
     }
 
     /**
-     * @brief      Updates the H fields forward in time
+     * @brief      Copies the interleaved pole storage of the fused dispersive updates into the polarization and magnetization grids or back
+     *
+     * @param[in]  toGrids  If true copy into lorPx_, prevLorPx_, etc., otherwise copy from them
      */
-    void updateH()
+    void copyPoleStores(bool toGrids)
     {
-        for(auto& up : upHx_)
-            upHxFxn_(std::get<0>(up), std::get<1>(up), Hx_, Ey_, Ez_);
-        for(auto& up : upHy_)
-            upHyFxn_(std::get<0>(up), std::get<1>(up), Hy_, Ez_, Ex_);
-        for(auto& up : upHz_)
-            upHzFxn_(std::get<0>(up), std::get<1>(up), Hz_, Ex_, Ey_);
+        std::array<upLists*,6> lists = {{ &upDx_, &upDy_, &upDz_, &upBx_, &upBy_, &upBz_ }};
+        std::array<std::vector<pgrid_ptr>*,6> lor = {{ &lorPx_, &lorPy_, &lorPz_, &lorMx_, &lorMy_, &lorMz_ }};
+        std::array<std::vector<pgrid_ptr>*,6> prevLor = {{ &prevLorPx_, &prevLorPy_, &prevLorPz_, &prevLorMx_, &prevLorMy_, &prevLorMz_ }};
+        for(int ss = 0; ss < 6; ++ss)
+        {
+            if(!poleStores_[ss] || lor[ss]->empty() )
+                continue;
+            if(toGrids)
+                poleStores_[ss]->toGrids(*lists[ss], *lor[ss], *prevLor[ss]);
+            else
+                poleStores_[ss]->fromGrids(*lists[ss], *lor[ss], *prevLor[ss]);
+        }
     }
 
     /**
-     * @brief      Updates the E fields forward in time
+     * @brief      Takes over the pole stores that have no full pole grids from a propagator made from the same inputs, must be called by all processes
+     * @details    The compact stores are spread out into temporary grids with the layouts of the old and new D (or B) grids, which are moved between processes like the field grids.
+     *
+     * @param      old   The propagator being replaced
      */
-    void updateE()
+    void migratePoleStores(parallelFDTDFieldBase<T>& old)
     {
-        for(auto& up : upEx_)
-            upExFxn_(std::get<0>(up), std::get<1>(up), Ex_, Hy_, Hz_);
-        for(auto& up : upEy_)
-            upEyFxn_(std::get<0>(up), std::get<1>(up), Ey_, Hz_, Hx_);
-        for(auto& up : upEz_)
-            upEzFxn_(std::get<0>(up), std::get<1>(up), Ez_, Hx_, Hy_);
+        std::array<upLists*,6> lists = {{ &upDx_, &upDy_, &upDz_, &upBx_, &upBy_, &upBz_ }};
+        std::array<upLists*,6> oldLists = {{ &old.upDx_, &old.upDy_, &old.upDz_, &old.upBx_, &old.upBy_, &old.upBz_ }};
+        std::array<pgrid_ptr,6> layouts = {{ Dx_, Dy_, Dz_, Bx_, By_, Bz_ }};
+        std::array<pgrid_ptr,6> oldLayouts = {{ old.Dx_, old.Dy_, old.Dz_, old.Bx_, old.By_, old.Bz_ }};
+        std::array<std::vector<pgrid_ptr>*,6> lor = {{ &lorPx_, &lorPy_, &lorPz_, &lorMx_, &lorMy_, &lorMz_ }};
+        for(int ss = 0; ss < 6; ++ss)
+        {
+            if( (poleStores_[ss] == nullptr) != (old.poleStores_[ss] == nullptr) )
+                throw std::logic_error("A propagator can only take over the state of a propagator made from the same inputs");
+            if(!poleStores_[ss] || !lor[ss]->empty() || poleStores_[ss]->maxPoles() == 0)
+                continue;
+            // The load balancer has already changed the boundaries the weights give, so copy the layouts of the old and new D (or B) grids
+            std::vector<pgrid_ptr> oldCur, oldPrev, cur, prev;
+            for(int pp = 0; pp < poleStores_[ss]->maxPoles(); ++pp)
+            {
+                for(auto grids : {&oldCur, &oldPrev})
+                    grids->push_back(std::make_shared<parallelGrid<T>>(oldLayouts[ss]) );
+                for(auto grids : {&cur, &prev})
+                    grids->push_back(std::make_shared<parallelGrid<T>>(layouts[ss]) );
+            }
+            old.poleStores_[ss]->toGrids(*oldLists[ss], oldCur, oldPrev);
+            for(int pp = 0; pp < cur.size(); ++pp)
+            {
+                cur[pp]->migrateFrom(oldCur[pp]);
+                prev[pp]->migrateFrom(oldPrev[pp]);
+            }
+            poleStores_[ss]->fromGrids(*lists[ss], cur, prev);
+        }
     }
 
     /**
-     * @brief      Updates the B fields forward in time
+     * @brief      Waits for all outstanding field transfers, needed before reading the fields after a step
      */
-    void updateB()
+    void finishTransfers()
     {
-        for(auto& up : upBx_)
-            upHxFxn_(std::get<0>(up), std::get<1>(up), Bx_, Ey_, Ez_);
-        for(auto& up : upBy_)
-            upHyFxn_(std::get<0>(up), std::get<1>(up), By_, Ez_, Ex_);
-        for(auto& up : upBz_)
-            upHzFxn_(std::get<0>(up), std::get<1>(up), Bz_, Ex_, Ey_);
+        transferE_->finish();
     }
 
     /**
-     * @brief      Updates the D fields forward in time
+     * @return     The total wall time spent waiting for the halo exchanges
+     */
+    inline double commWaitTime() {return transferE_->waitTime() + transferH_->waitTime();}
+
+    /**
+     * @return     The first global grid point of this process in each direction (without the transfer regions)
      */
-    void updateD()
+    inline std::array<int,3> procLoc() {return phys_Ex_->procLoc();}
+
+    /**
+     * @return     The number of grid points of this process in each direction (without the transfer regions)
+     */
+    inline std::array<int,3> localSize() {return std::array<int,3>({{ phys_Ex_->local_x()-2, phys_Ex_->local_y()-2, phys_Ex_->local_z()-2 }});}
+
+    /**
+     * @brief      Gets all grids that store the state of the calculation
+     *
+     * @return     The fields, D/B fields, and polarization and magnetization fields in a fixed order (nullptr for ones that are not used)
+     */
+    std::vector<pgrid_ptr> stateGrids()
     {
-        for(auto& up : upDx_)
-            upExFxn_(std::get<0>(up), std::get<1>(up), Dx_, Hy_, Hz_);
-        for(auto& up : upDy_)
-            upEyFxn_(std::get<0>(up), std::get<1>(up), Dy_, Hz_, Hx_);
-        for(auto& up : upDz_)
-            upEzFxn_(std::get<0>(up), std::get<1>(up), Dz_, Hx_, Hy_);
+        copyPoleStores(true);
+        std::vector<pgrid_ptr> grids = {{ Hx_, Hy_, Hz_, Ex_, Ey_, Ez_, Bx_, By_, Bz_, Dx_, Dy_, Dz_ }};
+        for(auto lor : {&lorPx_, &lorPy_, &lorPz_, &prevLorPx_, &prevLorPy_, &prevLorPz_, &lorMx_, &lorMy_, &lorMz_, &prevLorMx_, &prevLorMy_, &prevLorMz_})
+            grids.insert(grids.end(), lor->begin(), lor->end() );
+        return grids;
     }
 
     /**
-     * @brief      Updates the polarization fields and adds them to the D field to get the E field for electrically dispersive materials
+     * @brief      Finishes all transfers and closes the detector output files so a propagator built with new process boundaries can take over, must be called by all processes
      */
-    void updateDispE()
+    void closeOutputs()
     {
-        for(auto& up : upDx_)
+        finishTransfers();
+        for(auto & dtc : dtcArr_)
+            dtc->closeOutput();
+        gridComm_->barrier();
+    }
+
+    /**
+     * @brief      Takes over the state of a propagator built from the same inputs with different y process boundaries, must be called by all processes
+     * @details    The grids are moved between processes by global y row. The TFSF incident fields are copied and the frequency detectors and flux objects move what they collected to their new output processes.
+     *
+     * @param      old   The propagator being replaced (closeOutputs must be called on it before this propagator is constructed)
+     */
+    void migrateFrom(parallelFDTDFieldBase<T>& old)
+    {
+        std::vector<pgrid_ptr> grids = stateGrids();
+        std::vector<pgrid_ptr> oldGrids = old.stateGrids();
+        if(grids.size() != oldGrids.size() || tfsfArr_.size() != old.tfsfArr_.size() || dtcFreqArr_.size() != old.dtcFreqArr_.size() || fluxArr_.size() != old.fluxArr_.size() )
+            throw std::logic_error("A propagator can only take over the state of a propagator made from the same inputs");
+        for(int gg = 0; gg < grids.size(); ++gg)
         {
-            upLorPxFxn_( std::get<0>(up), Ex_, lorPx_, prevLorPx_, scratch_.data(), objArr_[ std::get<0>(up)[7] ]);
-            D2ExFxn_( std::get<0>(up), Dx_, Ex_, lorPx_, objArr_[ std::get<0>(up)[7] ]);
+            if( (grids[gg] == nullptr) != (oldGrids[gg] == nullptr) )
+                throw std::logic_error("A propagator can only take over the state of a propagator made from the same inputs");
+            if(grids[gg])
+                grids[gg]->migrateFrom(oldGrids[gg]);
         }
-        for(auto& up : upDy_)
+        copyPoleStores(false);
+        migratePoleStores(old);
+        // The PML auxiliary fields are only stored inside the PMLs so the PMLs move them
+        std::array<pml_ptr,6> pmls = {{ ExPML_, EyPML_, EzPML_, HxPML_, HyPML_, HzPML_ }};
+        std::array<pml_ptr,6> oldPmls = {{ old.ExPML_, old.EyPML_, old.EzPML_, old.HxPML_, old.HyPML_, old.HzPML_ }};
+        for(int pp = 0; pp < pmls.size(); ++pp)
         {
-            upLorPyFxn_( std::get<0>(up), Ey_, lorPy_, prevLorPy_, scratch_.data(), objArr_[ std::get<0>(up)[7] ]);
-            D2EyFxn_( std::get<0>(up), Dy_, Ey_, lorPy_, objArr_[ std::get<0>(up)[7] ]);
+            if( (pmls[pp] == nullptr) != (oldPmls[pp] == nullptr) )
+                throw std::logic_error("A propagator can only take over the state of a propagator made from the same inputs");
+            if(pmls[pp])
+                pmls[pp]->migrateFrom(*oldPmls[pp]);
         }
-        for(auto& up : upDz_)
+        t_step_ = old.t_step_;
+        tcur_ = old.tcur_;
+        E_incd_ = old.E_incd_;
+        E_pl_incd_ = old.E_pl_incd_;
+        H_incd_ = old.H_incd_;
+        H_mn_incd_ = old.H_mn_incd_;
+        for(int ii = 0; ii < tfsfArr_.size(); ++ii)
+            tfsfArr_[ii]->copyIncdState(*old.tfsfArr_[ii]);
+        for(int ii = 0; ii < dtcFreqArr_.size(); ++ii)
+            dtcFreqArr_[ii]->migrateFrom(*old.dtcFreqArr_[ii]);
+        for(int ii = 0; ii < fluxArr_.size(); ++ii)
+            fluxArr_[ii]->migrateFrom(*old.fluxArr_[ii]);
+    }
+
+    /**
+     * @brief      Updates the H fields forward in time
+     *
+     * @param[in]  halo  If true update the points that need the transfer regions, otherwise update all other points
+     */
+    void updateH(bool halo)
+    {
+        // Each field component is independent of the others so the threads never need to synchronize inside the region
+        #pragma omp parallel num_threads(nThreads_)
         {
-            upLorPzFxn_( std::get<0>(up), Ez_, lorPz_, prevLorPz_, scratch_.data(), objArr_[ std::get<0>(up)[7] ]);
-            D2EzFxn_( std::get<0>(up), Dz_, Ez_, lorPz_, objArr_[ std::get<0>(up)[7] ]);
+            int tt = threadID() + (halo ? nThreads_ : 0);
+            if(usePlans_)
+            {
+                curlPlans_[0].update(thdHx_[tt], thdHx_[tt+1], Hx_, Ey_, Ez_);
+                curlPlans_[1].update(thdHy_[tt], thdHy_[tt+1], Hy_, Ez_, Ex_);
+                curlPlans_[2].update(thdHz_[tt], thdHz_[tt+1], Hz_, Ex_, Ey_);
+            }
+            else
+            {
+                for(int ii = thdHx_[tt]; ii < thdHx_[tt+1]; ++ii)
+                    upHxFxn_(std::get<0>(upHx_[ii]), std::get<1>(upHx_[ii]), Hx_, Ey_, Ez_);
+                for(int ii = thdHy_[tt]; ii < thdHy_[tt+1]; ++ii)
+                    upHyFxn_(std::get<0>(upHy_[ii]), std::get<1>(upHy_[ii]), Hy_, Ez_, Ex_);
+                for(int ii = thdHz_[tt]; ii < thdHz_[tt+1]; ++ii)
+                    upHzFxn_(std::get<0>(upHz_[ii]), std::get<1>(upHz_[ii]), Hz_, Ex_, Ey_);
+            }
         }
     }
 
     /**
-     * @brief      Updates the magnetization fields and adds them to the B field to get the H field for magnetically dispersive materials
+     * @brief      Updates the E fields forward in time
+     *
+     * @param[in]  halo  If true update the points that need the transfer regions, otherwise update all other points
      */
-    void updateMagH()
+    void updateE(bool halo)
     {
-        for(auto& up : upBx_)
+        #pragma omp parallel num_threads(nThreads_)
         {
-            upLorMxFxn_( std::get<0>(up), Hx_, lorMx_, prevLorMx_, scratch_.data(), objArr_[ std::get<0>(up)[7] ]);
-            B2HxFxn_( std::get<0>(up), Bx_, Hx_, lorMx_, objArr_[ std::get<0>(up)[7] ]);
+            int tt = threadID() + (halo ? nThreads_ : 0);
+            if(usePlans_)
+            {
+                curlPlans_[3].update(thdEx_[tt], thdEx_[tt+1], Ex_, Hy_, Hz_);
+                curlPlans_[4].update(thdEy_[tt], thdEy_[tt+1], Ey_, Hz_, Hx_);
+                curlPlans_[5].update(thdEz_[tt], thdEz_[tt+1], Ez_, Hx_, Hy_);
+            }
+            else
+            {
+                for(int ii = thdEx_[tt]; ii < thdEx_[tt+1]; ++ii)
+                    upExFxn_(std::get<0>(upEx_[ii]), std::get<1>(upEx_[ii]), Ex_, Hy_, Hz_);
+                for(int ii = thdEy_[tt]; ii < thdEy_[tt+1]; ++ii)
+                    upEyFxn_(std::get<0>(upEy_[ii]), std::get<1>(upEy_[ii]), Ey_, Hz_, Hx_);
+                for(int ii = thdEz_[tt]; ii < thdEz_[tt+1]; ++ii)
+                    upEzFxn_(std::get<0>(upEz_[ii]), std::get<1>(upEz_[ii]), Ez_, Hx_, Hy_);
+            }
         }
-        for(auto& up : upBy_)
+    }
+
+    /**
+     * @brief      Updates the B fields forward in time
+     *
+     * @param[in]  halo  If true update the points that need the transfer regions, otherwise update all other points
+     */
+    void updateB(bool halo)
+    {
+        #pragma omp parallel num_threads(nThreads_)
         {
-            upLorMyFxn_( std::get<0>(up), Hy_, lorMy_, prevLorMy_, scratch_.data(), objArr_[ std::get<0>(up)[7] ]);
-            B2HyFxn_( std::get<0>(up), By_, Hy_, lorMy_, objArr_[ std::get<0>(up)[7] ]);
+            int tt = threadID() + (halo ? nThreads_ : 0);
+            if(usePlans_)
+            {
+                curlPlans_[6].update(thdBx_[tt], thdBx_[tt+1], Bx_, Ey_, Ez_);
+                curlPlans_[7].update(thdBy_[tt], thdBy_[tt+1], By_, Ez_, Ex_);
+                curlPlans_[8].update(thdBz_[tt], thdBz_[tt+1], Bz_, Ex_, Ey_);
+            }
+            else
+            {
+                for(int ii = thdBx_[tt]; ii < thdBx_[tt+1]; ++ii)
+                    upHxFxn_(std::get<0>(upBx_[ii]), std::get<1>(upBx_[ii]), Bx_, Ey_, Ez_);
+                for(int ii = thdBy_[tt]; ii < thdBy_[tt+1]; ++ii)
+                    upHyFxn_(std::get<0>(upBy_[ii]), std::get<1>(upBy_[ii]), By_, Ez_, Ex_);
+                for(int ii = thdBz_[tt]; ii < thdBz_[tt+1]; ++ii)
+                    upHzFxn_(std::get<0>(upBz_[ii]), std::get<1>(upBz_[ii]), Bz_, Ex_, Ey_);
+            }
         }
-        for(auto& up : upBz_)
+    }
+
+    /**
+     * @brief      Updates the D fields forward in time
+     *
+     * @param[in]  halo  If true update the points that need the transfer regions, otherwise update all other points
+     */
+    void updateD(bool halo)
+    {
+        #pragma omp parallel num_threads(nThreads_)
         {
-            upLorMzFxn_( std::get<0>(up), Hz_, lorMz_, prevLorMz_, scratch_.data(), objArr_[ std::get<0>(up)[7] ]);
-            B2HzFxn_( std::get<0>(up), Bz_, Hz_, lorMz_, objArr_[ std::get<0>(up)[7] ]);
+            int tt = threadID() + (halo ? nThreads_ : 0);
+            if(usePlans_)
+            {
+                curlPlans_[9].update(thdDx_[tt], thdDx_[tt+1], Dx_, Hy_, Hz_);
+                curlPlans_[10].update(thdDy_[tt], thdDy_[tt+1], Dy_, Hz_, Hx_);
+                curlPlans_[11].update(thdDz_[tt], thdDz_[tt+1], Dz_, Hx_, Hy_);
+            }
+            else
+            {
+                for(int ii = thdDx_[tt]; ii < thdDx_[tt+1]; ++ii)
+                    upExFxn_(std::get<0>(upDx_[ii]), std::get<1>(upDx_[ii]), Dx_, Hy_, Hz_);
+                for(int ii = thdDy_[tt]; ii < thdDy_[tt+1]; ++ii)
+                    upEyFxn_(std::get<0>(upDy_[ii]), std::get<1>(upDy_[ii]), Dy_, Hz_, Hx_);
+                for(int ii = thdDz_[tt]; ii < thdDz_[tt+1]; ++ii)
+                    upEzFxn_(std::get<0>(upDz_[ii]), std::get<1>(upDz_[ii]), Dz_, Hx_, Hy_);
+            }
+        }
+    }
+
+    /**
+     * @brief      Updates the polarization fields and adds them to the D field to get the E field for electrically dispersive materials
+     */
+    void updateDispE()
+    {
+        #pragma omp parallel num_threads(nThreads_)
+        {
+            T* jstore = threadScratch();
+            // Loop over the runs that do not need the transfer regions then the ones that do
+            for(int tt = threadID(); tt < 2*nThreads_; tt += nThreads_)
+            {
+                for(int ii = thdDx_[tt]; ii < thdDx_[tt+1]; ++ii)
+                {
+                    if(poleStores_[0])
+                    {
+                        poleStores_[0]->update(ii, std::get<0>(upDx_[ii]), Dx_, Ex_);
+                        continue;
+                    }
+                    upLorPxFxn_( std::get<0>(upDx_[ii]), Ex_, lorPx_, prevLorPx_, jstore, objArr_[ std::get<0>(upDx_[ii])[7] ]);
+                    D2ExFxn_( std::get<0>(upDx_[ii]), Dx_, Ex_, lorPx_, objArr_[ std::get<0>(upDx_[ii])[7] ]);
+                }
+                for(int ii = thdDy_[tt]; ii < thdDy_[tt+1]; ++ii)
+                {
+                    if(poleStores_[1])
+                    {
+                        poleStores_[1]->update(ii, std::get<0>(upDy_[ii]), Dy_, Ey_);
+                        continue;
+                    }
+                    upLorPyFxn_( std::get<0>(upDy_[ii]), Ey_, lorPy_, prevLorPy_, jstore, objArr_[ std::get<0>(upDy_[ii])[7] ]);
+                    D2EyFxn_( std::get<0>(upDy_[ii]), Dy_, Ey_, lorPy_, objArr_[ std::get<0>(upDy_[ii])[7] ]);
+                }
+                for(int ii = thdDz_[tt]; ii < thdDz_[tt+1]; ++ii)
+                {
+                    if(poleStores_[2])
+                    {
+                        poleStores_[2]->update(ii, std::get<0>(upDz_[ii]), Dz_, Ez_);
+                        continue;
+                    }
+                    upLorPzFxn_( std::get<0>(upDz_[ii]), Ez_, lorPz_, prevLorPz_, jstore, objArr_[ std::get<0>(upDz_[ii])[7] ]);
+                    D2EzFxn_( std::get<0>(upDz_[ii]), Dz_, Ez_, lorPz_, objArr_[ std::get<0>(upDz_[ii])[7] ]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief      Updates the magnetization fields and adds them to the B field to get the H field for magnetically dispersive materials
+     */
+    void updateMagH()
+    {
+        #pragma omp parallel num_threads(nThreads_)
+        {
+            T* jstore = threadScratch();
+            // Loop over the runs that do not need the transfer regions then the ones that do
+            for(int tt = threadID(); tt < 2*nThreads_; tt += nThreads_)
+            {
+                for(int ii = thdBx_[tt]; ii < thdBx_[tt+1]; ++ii)
+                {
+                    if(poleStores_[3])
+                    {
+                        poleStores_[3]->update(ii, std::get<0>(upBx_[ii]), Bx_, Hx_);
+                        continue;
+                    }
+                    upLorMxFxn_( std::get<0>(upBx_[ii]), Hx_, lorMx_, prevLorMx_, jstore, objArr_[ std::get<0>(upBx_[ii])[7] ]);
+                    B2HxFxn_( std::get<0>(upBx_[ii]), Bx_, Hx_, lorMx_, objArr_[ std::get<0>(upBx_[ii])[7] ]);
+                }
+                for(int ii = thdBy_[tt]; ii < thdBy_[tt+1]; ++ii)
+                {
+                    if(poleStores_[4])
+                    {
+                        poleStores_[4]->update(ii, std::get<0>(upBy_[ii]), By_, Hy_);
+                        continue;
+                    }
+                    upLorMyFxn_( std::get<0>(upBy_[ii]), Hy_, lorMy_, prevLorMy_, jstore, objArr_[ std::get<0>(upBy_[ii])[7] ]);
+                    B2HyFxn_( std::get<0>(upBy_[ii]), By_, Hy_, lorMy_, objArr_[ std::get<0>(upBy_[ii])[7] ]);
+                }
+                for(int ii = thdBz_[tt]; ii < thdBz_[tt+1]; ++ii)
+                {
+                    if(poleStores_[5])
+                    {
+                        poleStores_[5]->update(ii, std::get<0>(upBz_[ii]), Bz_, Hz_);
+                        continue;
+                    }
+                    upLorMzFxn_( std::get<0>(upBz_[ii]), Hz_, lorMz_, prevLorMz_, jstore, objArr_[ std::get<0>(upBz_[ii])[7] ]);
+                    B2HzFxn_( std::get<0>(upBz_[ii]), Bz_, Hz_, lorMz_, objArr_[ std::get<0>(upBz_[ii])[7] ]);
+                }
+            }
         }
     }
 
@@ -1315,4 +2579,37 @@ public:
     void coustructDTC(DTCCLASS c, std::vector<cplx_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, GRIDOUTFXN fxn, GRIDOUTTYPE txtType, DTCTYPE type, std::vector<double> freqList, double timeInterval, double a, double I0, double t_max);
 };
 
+class parallelFDTDFieldFloat : public parallelFDTDFieldBase<float>
+{
+public:
+    /**
+     * @brief      Constructs a FDTD Propagator class that stores the fields in single precision
+     *
+     * @param[in]  IP        Input parameter object that read in values from a json input file
+     * @param[in]  gridComm  A shared_ptr to the MPI interface for the calculation
+     */
+    parallelFDTDFieldFloat(parallelProgramInputs &IP, std::shared_ptr<mpiInterface> gridComm);
+
+
+    /**
+     * @brief      Constructs a DTC based off of the input parameters and puts it in the proper detector vector
+     *
+     * @param[in]  c             class type of the dtc (bin, bmp, cout, txt, freq)
+     * @param[in]  grid          vector of the fields that need to be outputted
+     * @param[in]  SI            true if outputting in SI units
+     * @param[in]  loc           The location of the detectors lower left corner in grid points
+     * @param[in]  sz            The size of the detector in grid points
+     * @param[in]  out_name      The output file name
+     * @param[in]  fxn           Function used to modify base field data
+     * @param[in]  txtType       if BMP what should be outputted to the text file
+     * @param[in]  type          The type of the detector (Ex, Ey, Epow, etc)
+     * @param[in]  freqList      The frequency list
+     * @param[in]  timeInterval  The number of time steps per field output
+     * @param[in]  a             unit length of the calculation
+     * @param[in]  I0            unit current of the calculation
+     * @param[in]  t_max         The time at the final time step
+     */
+    void coustructDTC(DTCCLASS c, std::vector<float_pgrid_ptr> grid, bool SI, std::array<int,3> loc, std::array<int,3> sz, std::string out_name, GRIDOUTFXN fxn, GRIDOUTTYPE txtType, DTCTYPE type, std::vector<double> freqList, double timeInterval, double a, double I0, double t_max);
+};
+
 #endif
\ No newline at end of file
@@ -2,11 +2,13 @@
 #define FDTD_PARALLELGRID
 
 #include <MPI/mpiInterface.hpp>
+#include <MPI/persistentRequests.hpp>
 #include <UTIL/enum.hpp>
 #include <UTIL/mathUtils.hpp>
 #include <boost/serialization/complex.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/array.hpp>
+#include <algorithm>
 #include <iomanip>
 #include <utility>
 #include <numeric>
@@ -26,14 +28,12 @@ protected:
 
     // Local Parameters
     std::array<int,3> ln_vec_; //!< number of grid points of the local (single process) gird in all directions
+    int yStart_; //!< first local y row that is stored (0 unless the rows are restricted)
+    int yEnd_; //!< one past the last local y row that is stored (ln_vec_[1] unless the rows are restricted)
 
-    int upProc_; //!< The process that stores the data directly above the current process, -1 for none
-    int downProc_; //!< The process that stores the data directly below the current process, -1 for none
-
-    int upSendTag_; //!< Tag used for sending data to the process above (positive y direction)
-    int upRecvTag_; //!< Tag used for receiving data from the process above (positive y direction)
-    int downSendTag_; //!< Tag used for sending data to the process below (negative y direction)
-    int downRecvTag_; //!< Tag used for receiving data from the process below (negative y direction)
+    std::array<int,6> procNeigh_; //!< The process that stores the data directly next to the current process in each PROC_DIR, -1 for none
+    std::array<int,6> sendTag_; //!< Tags used for sending data to the neighboring process in each PROC_DIR
+    std::array<int,6> recvTag_; //!< Tags used for receiving data from the neighboring process in each PROC_DIR
 
     int upSendIndex_; //!< Typically ln_vec_[1]-2, if periodic and filed is limited in y then ln_vec_[1]-3
 
@@ -47,10 +47,14 @@ protected:
     std::vector<int> yTrans_; //!< Vector storing the index of each process' starting location value
     std::vector<int> zTrans_; //!< Vector storing the index of each process' starting location value
 
-    std::array<PROC_DIR, 2> sendList_; //!< List of send command parameters for each process
-    std::array<PROC_DIR, 2> recvList_; //!< List of recv command parameters for each process
+    std::array<PROC_DIR, 6> sendList_; //!< List of send command parameters for each process (ordered x, z, y)
+    std::array<PROC_DIR, 6> recvList_; //!< List of recv command parameters for each process (ordered x, z, y)
+
+    std::array<std::vector<T>, 6> sendBuf_; //!< Packing buffers for the transfer planes sent in each PROC_DIR
+    std::array<std::vector<T>, 6> recvBuf_; //!< Unpacking buffers for the transfer planes received from each PROC_DIR
 
-    std::vector<mpi::request> reqs_; //!< vector to store all mpi requests for waiting at each transfer point
+    persistentRequests<T> transferReqs_; //!< persistent sends and receives of the transfer planes, made once since the buffers and neighbors never change
+    std::array<int,4> pairReqs_; //!< index of the first request of each pair of directions (x, z, y) in transferReqs_, the last element is one past the last request
 
     // distributed parameters
     std::unique_ptr<T[]> local_; //!< Data array for the local grid
@@ -69,19 +73,20 @@ public:
         gridComm_(gridComm),
         n_vec_(n_vec),
         ln_vec_({{0,0,0}}),
-        upProc_(-1),
-        downProc_(-1),
-        upSendTag_(-1),
-        upRecvTag_(-1),
-        downSendTag_(-1),
-        downRecvTag_(-1),
+        yStart_(0),
+        yEnd_(0),
+        procNeigh_({{-1, -1, -1, -1, -1, -1}}),
+        sendTag_({{-1, -1, -1, -1, -1, -1}}),
+        recvTag_({{-1, -1, -1, -1, -1, -1}}),
         PBC_(PBC),
         d_(d),
         procLoc_(std::array<int,3>({0,0,0})),
         procR_C_(std::array<int,3>({0,0,0})),
         xTrans_(gridComm_->npX(),0),
         yTrans_(gridComm_->npY(),0),
-        zTrans_(gridComm_->npZ(),0)
+        zTrans_(gridComm_->npZ(),0),
+        transferReqs_(gridComm),
+        pairReqs_({{0, 0, 0, 0}})
     {
         std::tie(ln_vec_[0],ln_vec_[1], ln_vec_[2]) = gridComm_->numroc(n_vec_[0], n_vec_[1], n_vec_[2]);
         if(n_vec_[0] == 1)
@@ -90,15 +95,16 @@ public:
             ln_vec_[1] = 1;
         if(n_vec_[2] == 1)
             ln_vec_[2] = 1;
+        yEnd_ = ln_vec_[1];
         local_ = std::unique_ptr<T[]>(new T[size()]);
         zero();
 
         genProcSendRecv(PBC);
-        reqs_ = std::vector<mpi::request>(sendList_.size()*2,mpi::request());
+        setupTransferReqs();
         upSendIndex_ = ln_vec_[1]-2;
         // Find the procLocation of lower left corner in the grid Assumes Cartesian Grid for the procs
         determineProcLoc();
-        if(PBC && (gridComm_->rank() == gridComm_->size() - 1) && ylim)
+        if(PBC && (gridComm_->mypY() == gridComm_->npY() - 1) && ylim)
             upSendIndex_ -= 1;
     }
     /**
@@ -106,28 +112,29 @@ public:
      *
      * @param      gridComm  The mpiInterface for communication
      * @param[in]  PBC       True if periodic
-     * @param[in]  weights   Vector containing information of the work load for each point
+     * @param[in]  weights   Summed work load of every plane normal to each direction, used to place the process boundaries
      * @param[in]  n_vec     Size of the grid in all directions
      * @param[in]  d         grid spacing in all directions
      * @param[in]  ylim      True if grid is for Ey, Hx or Hz fields.
      */
-    parallelGrid(std::shared_ptr<mpiInterface> gridComm, bool PBC, std::vector<real_grid_ptr> weights, std::array<int,3> n_vec, std::array<double,3> d, bool ylim=false) :
+    parallelGrid(std::shared_ptr<mpiInterface> gridComm, bool PBC, const planeWeightSums& weights, std::array<int,3> n_vec, std::array<double,3> d, bool ylim=false) :
         gridComm_(gridComm),
         n_vec_(n_vec),
         ln_vec_({{0,0,0}}),
-        upProc_(-1),
-        downProc_(-1),
-        upSendTag_(-1),
-        upRecvTag_(-1),
-        downSendTag_(-1),
-        downRecvTag_(-1),
+        yStart_(0),
+        yEnd_(0),
+        procNeigh_({{-1, -1, -1, -1, -1, -1}}),
+        sendTag_({{-1, -1, -1, -1, -1, -1}}),
+        recvTag_({{-1, -1, -1, -1, -1, -1}}),
         PBC_(PBC),
         d_(d),
         procLoc_(std::array<int,3>({0,0,0})),
         procR_C_(std::array<int,3>({0,0,0})),
         xTrans_(gridComm_->npX(),0),
         yTrans_(gridComm_->npY(),0),
-        zTrans_(gridComm_->npZ(),0)
+        zTrans_(gridComm_->npZ(),0),
+        transferReqs_(gridComm),
+        pairReqs_({{0, 0, 0, 0}})
     {
         std::tie(ln_vec_[0],ln_vec_[1], ln_vec_[2]) = gridComm_->getLocxLocyLocz(weights);
         if(n_vec_[0] == 1)
@@ -136,20 +143,53 @@ public:
             ln_vec_[1] = 1;
         if(n_vec_[2] == 1)
             ln_vec_[2] = 1;
+        yEnd_ = ln_vec_[1];
         local_ = std::unique_ptr<T[]>(new T[size()]);
         zero();
 
         genProcSendRecv(PBC);
-
-        reqs_ = std::vector<mpi::request>(sendList_.size()*2,mpi::request());
+        setupTransferReqs();
 
         // Find the procLocation of lower left corner in the grid Assumes Cartesian Grid for the procs
         determineProcLoc();
         upSendIndex_ = ln_vec_[1]-2;
-        if(PBC && (gridComm_->rank() == gridComm_->size() - 1) && ylim)
+        if(PBC && (gridComm_->mypY() == gridComm_->npY() - 1) && ylim)
             upSendIndex_ -= 1;
     }
 
+    /**
+     * @brief      constructs a parallelGrid with the same size and process boundaries as an existing grid (all rows are stored)
+     * @details    Used to move data out of grids made before the load balancer changed the process boundaries, since a grid made from the weights would get the new boundaries
+     *
+     * @param[in]  layout  The grid whose layout is copied
+     */
+    explicit parallelGrid(std::shared_ptr<parallelGrid<T>> layout) :
+        gridComm_(layout->gridComm_),
+        n_vec_(layout->n_vec_),
+        ln_vec_(layout->ln_vec_),
+        yStart_(0),
+        yEnd_(layout->ln_vec_[1]),
+        procNeigh_({{-1, -1, -1, -1, -1, -1}}),
+        sendTag_({{-1, -1, -1, -1, -1, -1}}),
+        recvTag_({{-1, -1, -1, -1, -1, -1}}),
+        upSendIndex_(layout->upSendIndex_),
+        PBC_(layout->PBC_),
+        d_(layout->d_),
+        procLoc_(layout->procLoc_),
+        procR_C_(layout->procR_C_),
+        xTrans_(layout->xTrans_),
+        yTrans_(layout->yTrans_),
+        zTrans_(layout->zTrans_),
+        transferReqs_(layout->gridComm_),
+        pairReqs_({{0, 0, 0, 0}})
+    {
+        local_ = std::unique_ptr<T[]>(new T[size()]);
+        zero();
+
+        genProcSendRecv(PBC_);
+        setupTransferReqs();
+    }
+
 
     /**
      * @brief     etermines which processors borders the current process
@@ -158,55 +198,104 @@ public:
      */
     void genProcSendRecv(bool PBC)
     {
-        int ii = gridComm_->rank();
-        // if the process is at the lower boundary down proc only exists with PBC
-        if(ii % gridComm_->npY() != 0)
-        {
-            downProc_ =  ii - 1;
-            downSendTag_ = gridComm_->cantorTagGen(gridComm_->rank(), downProc_, 4, 0);
-            downRecvTag_ = gridComm_->cantorTagGen(downProc_, gridComm_->rank(), 4, 1);
-        }
+        int px = gridComm_->mypX();
+        int py = gridComm_->mypY();
+        int pz = gridComm_->mypZ();
+        // if the process is at the lower boundary down proc only exists with PBC (PBC are only split in the y direction)
+        if(py != 0)
+            procNeigh_[static_cast<int>(PROC_DIR::DOWN)] = gridComm_->getRank(px, py-1, pz);
         else if(PBC)
-        {
-            downProc_ =  ii + gridComm_->npY()-1;
-            downSendTag_ = gridComm_->cantorTagGen(gridComm_->rank(), downProc_, 4, 0);
-            downRecvTag_ = gridComm_->cantorTagGen(downProc_, gridComm_->rank(), 4, 1);
-        }
+            procNeigh_[static_cast<int>(PROC_DIR::DOWN)] = gridComm_->getRank(px, gridComm_->npY()-1, pz);
 
         // if the process is at the upper boundary up proc only exists with PBC
-        if(ii % gridComm_->npY() != gridComm_->npY() - 1)
-        {
-            upProc_ =  ii + 1;
-            upSendTag_ = gridComm_->cantorTagGen(gridComm_->rank(), upProc_, 4, 1);
-            upRecvTag_ = gridComm_->cantorTagGen(upProc_, gridComm_->rank(), 4, 0);
-        }
+        if(py != gridComm_->npY() - 1)
+            procNeigh_[static_cast<int>(PROC_DIR::UP)] = gridComm_->getRank(px, py+1, pz);
         else if(PBC)
+            procNeigh_[static_cast<int>(PROC_DIR::UP)] = gridComm_->getRank(px, 0, pz);
+
+        // x and z neighbors only exist inside the process grid
+        if(px != 0)
+            procNeigh_[static_cast<int>(PROC_DIR::LEFT)] = gridComm_->getRank(px-1, py, pz);
+        if(px != gridComm_->npX() - 1)
+            procNeigh_[static_cast<int>(PROC_DIR::RIGHT)] = gridComm_->getRank(px+1, py, pz);
+        if(pz != 0)
+            procNeigh_[static_cast<int>(PROC_DIR::BACK)] = gridComm_->getRank(px, py, pz-1);
+        if(pz != gridComm_->npZ() - 1)
+            procNeigh_[static_cast<int>(PROC_DIR::FRONT)] = gridComm_->getRank(px, py, pz+1);
+
+        // Tags are offset by the direction the data is travelling in so two processes can be neighbors in multiple directions (PBC with npY <= 2)
+        for(int dd = 0; dd < procNeigh_.size(); ++dd)
         {
-            upProc_ =  ii - gridComm_->npY()+1;
-            upSendTag_ = gridComm_->cantorTagGen(gridComm_->rank(), upProc_, 4, 1);
-            upRecvTag_ = gridComm_->cantorTagGen(upProc_, gridComm_->rank(), 4, 0);
+            if(procNeigh_[dd] == -1)
+                continue;
+            sendTag_[dd] = gridComm_->cantorTagGen(gridComm_->rank(), procNeigh_[dd], 6, dd);
+            recvTag_[dd] = gridComm_->cantorTagGen(procNeigh_[dd], gridComm_->rank(), 6, static_cast<int>(oppositeDir(static_cast<PROC_DIR>(dd) ) ) );
         }
-        // if upProc_ is still -1 PROC_DIR == NONE otherwise its UP
-        if(upProc_ != -1)
+        // Data is passed along x, then z, then y so the edges of the transfer regions get filled by the later transfers, sending in one direction is paired with receiving from the opposite one
+        std::array<PROC_DIR, 6> sendOrder = {{PROC_DIR::RIGHT, PROC_DIR::LEFT, PROC_DIR::FRONT, PROC_DIR::BACK, PROC_DIR::UP, PROC_DIR::DOWN}};
+        for(int ii = 0; ii < sendOrder.size(); ++ii)
         {
-            sendList_[0] = PROC_DIR::UP;
-            recvList_[1] = PROC_DIR::UP;
+            PROC_DIR recvDir = oppositeDir(sendOrder[ii]);
+            sendList_[ii] = procNeigh_[static_cast<int>(sendOrder[ii])] != -1 ? sendOrder[ii] : PROC_DIR::NONE;
+            recvList_[ii] = procNeigh_[static_cast<int>(recvDir)] != -1 ? recvDir : PROC_DIR::NONE;
         }
-        else
+        // Buffers to pack the transfer planes into
+        for(int dd = 0; dd < procNeigh_.size(); ++dd)
         {
-            sendList_[0] = PROC_DIR::NONE;
-            recvList_[1] = PROC_DIR::NONE;
+            if(procNeigh_[dd] == -1)
+                continue;
+            sendBuf_[dd] = std::vector<T>(transferPlaneSize(static_cast<PROC_DIR>(dd)), 0.0);
+            recvBuf_[dd] = std::vector<T>(transferPlaneSize(static_cast<PROC_DIR>(dd)), 0.0);
         }
-        // if downProc_ is still -1 PROC_DIR == NONE otherwise its DOWN
-        if(downProc_ != -1)
+    }
+
+    /**
+     * @brief      Sets up the persistent sends and receives of the transfer planes for each pair of directions in sendList_
+     */
+    void setupTransferReqs()
+    {
+        transferReqs_.clear();
+        for(int pp = 0; pp < 3; ++pp)
         {
-            sendList_[1] = PROC_DIR::DOWN;
-            recvList_[0] = PROC_DIR::DOWN;
+            pairReqs_[pp] = transferReqs_.size();
+            for(int ii = 2*pp; ii < 2*pp + 2; ++ii)
+            {
+                int sd = static_cast<int>(sendList_[ii]);
+                int rd = static_cast<int>(recvList_[ii]);
+                if(sendList_[ii] != PROC_DIR::NONE)
+                    transferReqs_.addSend(sendBuf_[sd].data(), sendBuf_[sd].size(), procNeigh_[sd], sendTag_[sd]);
+                if(recvList_[ii] != PROC_DIR::NONE)
+                    transferReqs_.addRecv(recvBuf_[rd].data(), recvBuf_[rd].size(), procNeigh_[rd], recvTag_[rd]);
+            }
         }
-        else
+        pairReqs_[3] = transferReqs_.size();
+    }
+
+    /**
+     * @brief      Gets the direction opposite to dir
+     *
+     * @param[in]  dir   The direction
+     *
+     * @return     The opposite direction
+     */
+    static PROC_DIR oppositeDir(PROC_DIR dir)
+    {
+        switch(dir)
         {
-            sendList_[1] = PROC_DIR::NONE;
-            recvList_[0] = PROC_DIR::NONE;
+            case PROC_DIR::UP:
+                return PROC_DIR::DOWN;
+            case PROC_DIR::DOWN:
+                return PROC_DIR::UP;
+            case PROC_DIR::LEFT:
+                return PROC_DIR::RIGHT;
+            case PROC_DIR::RIGHT:
+                return PROC_DIR::LEFT;
+            case PROC_DIR::FRONT:
+                return PROC_DIR::BACK;
+            case PROC_DIR::BACK:
+                return PROC_DIR::FRONT;
+            default:
+                return PROC_DIR::NONE;
         }
     }
 
@@ -215,33 +304,30 @@ public:
      */
     void determineProcLoc()
     {
-        // Grids are split only in the y direction so these are always 0
-        procLoc_[0] = 0;
-        procLoc_[2] = 0;
-
-        procR_C_[0] = 0;
-        procR_C_[2] = 0;
-
-        int sumY = 0, tempY;
-        for(int ii = 0; ii < gridComm_->npY(); ii++)
+        // Every process needs the size of all other processes to find where they start
+        std::vector<int> allLnVec;
+        mpi::all_gather(*gridComm_, ln_vec_.data(), 3, allLnVec);
+        std::array<std::vector<int>*, 3> trans = {{ &xTrans_, &yTrans_, &zTrans_ }};
+        for(int dd = 0; dd < 3; ++dd)
         {
-            // yTrans stores all processes procR_C[1] value
-            yTrans_[ii] = sumY + 2*ii;
-            if(gridComm_->rank() % gridComm_->npY() == ii)
+            int sum = 0;
+            for(int ii = 0; ii < gridComm_->npArr()[dd]; ii++)
             {
-                // procLoc does not include boundary PBC storage regions, procR_C does
-                procLoc_[1] = sumY;
-                procR_C_[1] = sumY + ii*2;
+                // Move along the process grid in the dd direction from the process's current location
+                std::array<int,3> procPt = gridComm_->mypArr();
+                procPt[dd] = ii;
+                // trans stores all processes procR_C value
+                (*trans[dd])[ii] = sum + 2*ii;
+                if(gridComm_->mypArr()[dd] == ii)
+                {
+                    // procLoc does not include boundary PBC storage regions, procR_C does
+                    procLoc_[dd] = sum;
+                    procR_C_[dd] = sum + ii*2;
+                }
+                // local size without the boundary
+                sum += allLnVec[3*gridComm_->getRank(procPt[0], procPt[1], procPt[2]) + dd] - 2;
             }
-            // tempY does not include boundary
-            if(gridComm_->rank() == ii)
-                tempY = ln_vec_[1]-2;
-            // send tempY for the process to all processes
-            broadcast(*gridComm_, tempY, ii);
-            // add tempY to sumY
-            sumY += tempY;
         }
-
     }
 
     /**
@@ -273,8 +359,8 @@ public:
      */
     inline T& point(const int x, const int y)
     {
-        assert(0 <= x && x < ln_vec_[0] && 0 <= y && y < ln_vec_[1] );
-        return local_[y*ln_vec_[0]*ln_vec_[2] + x];
+        assert(0 <= x && x < ln_vec_[0] && yStart_ <= y && y < yEnd_ );
+        return local_[(y-yStart_)*ln_vec_[0]*ln_vec_[2] + x];
     }
 
     /**
@@ -286,8 +372,8 @@ public:
      * @return     reference to the data point at (x,y,0)
      */
     inline const T& point(const int x, const int y) const  {
-        assert(0 <= x && x < ln_vec_[0] && 0 <= y && y < ln_vec_[1] );
-        return local_[y*ln_vec_[0]*ln_vec_[2] + x];
+        assert(0 <= x && x < ln_vec_[0] && yStart_ <= y && y < yEnd_ );
+        return local_[(y-yStart_)*ln_vec_[0]*ln_vec_[2] + x];
     }
 
     /**
@@ -321,8 +407,8 @@ public:
      */
     inline T& point(const int x, const int y, const int z)
     {
-        assert(0 <= x && x < ln_vec_[0] && 0 <= y && y < ln_vec_[1] && 0 <= z && z < ln_vec_[2] );
-        return local_[y*ln_vec_[0]*ln_vec_[2] + z*ln_vec_[0] + x];
+        assert(0 <= x && x < ln_vec_[0] && yStart_ <= y && y < yEnd_ && 0 <= z && z < ln_vec_[2] );
+        return local_[(y-yStart_)*ln_vec_[0]*ln_vec_[2] + z*ln_vec_[0] + x];
     }
 
     /**
@@ -335,8 +421,8 @@ public:
      * @return     reference to the data point at (x,y,z)
      */
     inline const T& point(const int x, const int y, const int z) const  {
-        assert(0 <= x && x < ln_vec_[0] && 0 <= y && y < ln_vec_[1] && 0 <= z && z < ln_vec_[2] );
-        return local_[y*ln_vec_[0]*ln_vec_[2] + z*ln_vec_[0] + x];
+        assert(0 <= x && x < ln_vec_[0] && yStart_ <= y && y < yEnd_ && 0 <= z && z < ln_vec_[2] );
+        return local_[(y-yStart_)*ln_vec_[0]*ln_vec_[2] + z*ln_vec_[0] + x];
     }
 
     /**
@@ -361,6 +447,46 @@ public:
      */
     inline const T& operator()(const int x, const int y, const int z) const { return point(x,y,z); }
 
+    /**
+     * @return     pointer to the start of the local data (ordered y, z, x from slowest to fastest, starting at row yStart())
+     */
+    inline T* data() { return local_.get(); }
+
+    /**
+     * @return     const pointer to the start of the local data (ordered y, z, x from slowest to fastest, starting at row yStart())
+     */
+    inline const T* data() const { return local_.get(); }
+
+    /**
+     * @return     the first local y row that is stored
+     */
+    inline int yStart() const { return yStart_; }
+
+    /**
+     * @return     one past the last local y row that is stored
+     */
+    inline int yEnd() const { return yEnd_; }
+
+    /**
+     * @return     the flat index the first stored point would have in an unrestricted grid
+     */
+    inline int rowOffset() const { return yStart_*ln_vec_[0]*ln_vec_[2]; }
+
+    /**
+     * @brief      Only stores the local y rows yStart to yEnd-1, the other rows can not be accessed afterwards
+     * @details    Meant for auxiliary fields that are only updated in part of the cell; restricted grids can be migrated but not transferred or gathered. The stored rows are set to zero.
+     *
+     * @param[in]  yStart  The first local y row to store
+     * @param[in]  yEnd    One past the last local y row to store (nothing is stored if yEnd <= yStart)
+     */
+    void restrictRows(int yStart, int yEnd)
+    {
+        yStart_ = std::max(yStart, 0);
+        yEnd_ = std::max(std::min(yEnd, ln_vec_[1]), yStart_);
+        local_ = std::unique_ptr<T[]>(new T[size()]);
+        zero();
+    }
+
     /**
      * @brief Return the Data storage of the local grid
      * @return the Data storage of the local grid
@@ -374,7 +500,7 @@ public:
     /**
      * @return     total size of the storage vector
      */
-    inline int size() const { return ln_vec_[0]*ln_vec_[1]*ln_vec_[2]; }
+    inline int size() const { return ln_vec_[0]*(yEnd_-yStart_)*ln_vec_[2]; }
 
     /**
      * @return     the global number of grid points in the x direction
@@ -446,13 +572,23 @@ public:
      */
     inline std::array<int,3> procR_C() {return procR_C_;}
 
+    /**
+     * @return     the rank of the neighboring process in each PROC_DIR (-1 if there is none)
+     */
+    inline std::array<int,6> procNeigh() {return procNeigh_;}
+
+    /**
+     * @return     the first y row filled by the transfer from the UP process (one row lower for fields limited in y on the last process of a periodic grid)
+     */
+    inline int upRecvIndex() const {return upSendIndex_+1;}
+
 
     /**
      * @brief      Fills the local grid with a specified value
      *
      * @param[in]  a     value to fill vector with
      */
-    inline void fill(const T a) { std::fill_n(local_.get(), ln_vec_[0]*ln_vec_[1]*ln_vec_[2], a); }
+    inline void fill(const T a) { std::fill_n(local_.get(), size(), a); }
 
     /**
      * @brief Fills the local grid with zeros
@@ -472,39 +608,214 @@ public:
 
     /**
      * @brief      Transfer data from one process to another
+     * @details    Each direction's transfers are finished before the next one starts so the edges and corners of the transfer regions are passed on to the diagonal neighbors.
      */
     void transferDat()
     {
-        for(int ii = 0; ii < sendList_.size(); ii++)
+        for(int pp = 0; pp < 3; ++pp)
         {
-            switch(sendList_[ii])
-            {
-                case PROC_DIR::UP:
-                    reqs_[ii*2] = gridComm_->isend(  upProc_,   upSendTag_, &point(0,upSendIndex_,0), ln_vec_[0]*ln_vec_[2]);
-                    break;
-                case PROC_DIR::DOWN:
-                    reqs_[ii*2] = gridComm_->isend(downProc_, downSendTag_, &point(0,1,0), ln_vec_[0]*ln_vec_[2]);
-                    break;
-                case PROC_DIR::NONE:
-                    break;
-                default:
-                    throw std::logic_error("The PROC_DIR default has been hit, see transferDat() function to add the direction here.");
-            }
-            switch(recvList_[ii])
-            {
-                case PROC_DIR::UP:
-                    reqs_[ii*2+1] = gridComm_->irecv(  upProc_,   upRecvTag_, &point(0, upSendIndex_+1,0), ln_vec_[0]*ln_vec_[2]);
-                    break;
-                case PROC_DIR::DOWN:
-                    reqs_[ii*2+1] = gridComm_->irecv(downProc_, downRecvTag_, &point(0,0,0), ln_vec_[0]*ln_vec_[2]);
-                    break;
-                case PROC_DIR::NONE:
-                    break;
-                default:
-                    throw std::logic_error("The PROC_DIR default has been hit, see transferDat() function to add the direction here.");
-            }
-            mpi::wait_all(reqs_.data(), reqs_.data() + reqs_.size() );
+            for(int ii = 2*pp; ii < 2*pp + 2; ++ii)
+                if(sendList_[ii] != PROC_DIR::NONE)
+                    packTransferPlane(sendList_[ii], sendBuf_[static_cast<int>(sendList_[ii])].data());
+            transferReqs_.start(pairReqs_[pp], pairReqs_[pp+1]);
+            transferReqs_.wait(pairReqs_[pp], pairReqs_[pp+1]);
+            for(int ii = 2*pp; ii < 2*pp + 2; ++ii)
+                if(recvList_[ii] != PROC_DIR::NONE)
+                    unpackTransferPlane(recvList_[ii], recvBuf_[static_cast<int>(recvList_[ii])].data());
+        }
+    }
+
+    /**
+     * @brief      Fills the grid with the data of a grid of the same size that was split up with different y process boundaries
+     * @details    Every global y row is sent by the process that held it as an interior row, so the transfer regions between processes are filled as well. The rows outside the cell (including periodic copies) are taken from the process's own old grid. Only rows stored by both the old and the new grid are moved (see restrictRows). Must be called by all processes.
+     *
+     * @param[in]  old   The grid made with the old process boundaries
+     */
+    void migrateFrom(std::shared_ptr<parallelGrid<T>> old)
+    {
+        if(old->n_vec() != n_vec_ || old->local_x() != ln_vec_[0] || old->local_z() != ln_vec_[2])
+            throw std::logic_error("A parallelGrid can only take over the data of a grid with the same size and the same x and z process boundaries");
+        if(ln_vec_[1] == 1)
+        {
+            if(size() > 0 && old->size() > 0)
+                std::copy_n(old->data(), size(), local_.get());
+            return;
+        }
+        int rowSz = ln_vec_[0]*ln_vec_[2];
+        // Old first row, old size, new first row, new size, and the global first and one past the last stored old and new rows of every process
+        std::array<int,8> bounds = {{ old->procLoc()[1], old->local_y(), procLoc_[1], ln_vec_[1], old->procLoc()[1] + old->yStart() - 1, old->procLoc()[1] + old->yEnd() - 1, procLoc_[1] + yStart_ - 1, procLoc_[1] + yEnd_ - 1 }};
+        std::vector<int> allBounds;
+        mpi::all_gather(*gridComm_, bounds.data(), 8, allBounds);
+
+        std::vector<mpi::request> reqs;
+        for(int qq = 0; qq < gridComm_->npY(); ++qq)
+        {
+            int proc = gridComm_->getRank(gridComm_->mypX(), qq, gridComm_->mypZ() );
+            const int* procBounds = &allBounds[8*proc];
+            // Interior rows this process held that the other process needs (including its transfer regions)
+            int first = std::max({bounds[0], procBounds[2] - 1, bounds[4], procBounds[6]});
+            int last  = std::min({bounds[0] + bounds[1] - 2, procBounds[2] + procBounds[3] - 1, bounds[5], procBounds[7]});
+            if(first < last && proc != gridComm_->rank() )
+                reqs.push_back(gridComm_->isend(proc, gridComm_->cantorTagGen(gridComm_->rank(), proc, 2, 1), old->data() + (first - bounds[4])*rowSz, (last - first)*rowSz) );
+
+            // Interior rows the other process held that this process needs
+            first = std::max({procBounds[0], procLoc_[1] - 1, procBounds[4], bounds[6]});
+            last  = std::min({procBounds[0] + procBounds[1] - 2, procLoc_[1] + ln_vec_[1] - 1, procBounds[5], bounds[7]});
+            if(first >= last)
+                continue;
+            T* dest = local_.get() + (first - bounds[6])*rowSz;
+            if(proc == gridComm_->rank() )
+                std::copy_n(old->data() + (first - bounds[4])*rowSz, (last - first)*rowSz, dest);
+            else
+                reqs.push_back(gridComm_->irecv(proc, gridComm_->cantorTagGen(proc, gridComm_->rank(), 2, 1), dest, (last - first)*rowSz) );
         }
+        // The first and last processes in y keep the rows outside of the cell
+        if(gridComm_->mypY() == 0 && yStart_ == 0 && yEnd_ > 0 && old->yStart() == 0 && old->yEnd() > 0)
+            std::copy_n(old->data(), rowSz, local_.get() );
+        if(gridComm_->mypY() == gridComm_->npY() - 1 && yEnd_ == ln_vec_[1] && yStart_ < yEnd_ && old->yEnd() == old->local_y() && old->yStart() < old->yEnd() )
+            std::copy_n(old->data() + (old->local_y() - 1 - old->yStart() )*rowSz, rowSz, local_.get() + (ln_vec_[1] - 1 - yStart_)*rowSz);
+        mpi::wait_all(reqs.begin(), reqs.end() );
+    }
+
+    /**
+     * @brief      The number of points in the plane transferred to/from the neighboring process in direction dir
+     *
+     * @param[in]  dir   The direction of the neighboring process
+     *
+     * @return     The size of the transfer plane
+     */
+    int transferPlaneSize(PROC_DIR dir) const
+    {
+        switch(dir)
+        {
+            case PROC_DIR::UP:
+            case PROC_DIR::DOWN:
+                return ln_vec_[0]*ln_vec_[2];
+            case PROC_DIR::LEFT:
+            case PROC_DIR::RIGHT:
+                return ln_vec_[1]*ln_vec_[2];
+            case PROC_DIR::FRONT:
+            case PROC_DIR::BACK:
+                return ln_vec_[0]*ln_vec_[1];
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * @brief      Copies the plane that is sent to the neighboring process in direction dir into buf
+     *
+     * @param[in]  dir   The direction of the neighboring process
+     * @param      buf   The buffer to fill (at least transferPlaneSize(dir) long)
+     */
+    void packTransferPlane(PROC_DIR dir, T* buf)
+    {
+        switch(dir)
+        {
+            case PROC_DIR::UP:
+                std::copy_n(&point(0,upSendIndex_,0), ln_vec_[0]*ln_vec_[2], buf);
+                break;
+            case PROC_DIR::DOWN:
+                std::copy_n(&point(0,1,0), ln_vec_[0]*ln_vec_[2], buf);
+                break;
+            case PROC_DIR::RIGHT:
+                packPlaneYZ(ln_vec_[0]-2, buf);
+                break;
+            case PROC_DIR::LEFT:
+                packPlaneYZ(1, buf);
+                break;
+            case PROC_DIR::FRONT:
+                packPlaneXY(ln_vec_[2]-2, buf);
+                break;
+            case PROC_DIR::BACK:
+                packPlaneXY(1, buf);
+                break;
+            default:
+                throw std::logic_error("The PROC_DIR default has been hit, see packTransferPlane() function to add the direction here.");
+        }
+    }
+
+    /**
+     * @brief      Copies a plane received from the neighboring process in direction dir into the transfer region
+     *
+     * @param[in]  dir   The direction of the neighboring process
+     * @param[in]  buf   The received plane
+     */
+    void unpackTransferPlane(PROC_DIR dir, const T* buf)
+    {
+        switch(dir)
+        {
+            case PROC_DIR::UP:
+                std::copy_n(buf, ln_vec_[0]*ln_vec_[2], &point(0,upSendIndex_+1,0));
+                break;
+            case PROC_DIR::DOWN:
+                std::copy_n(buf, ln_vec_[0]*ln_vec_[2], &point(0,0,0));
+                break;
+            case PROC_DIR::RIGHT:
+                unpackPlaneYZ(ln_vec_[0]-1, buf);
+                break;
+            case PROC_DIR::LEFT:
+                unpackPlaneYZ(0, buf);
+                break;
+            case PROC_DIR::FRONT:
+                unpackPlaneXY(ln_vec_[2]-1, buf);
+                break;
+            case PROC_DIR::BACK:
+                unpackPlaneXY(0, buf);
+                break;
+            default:
+                throw std::logic_error("The PROC_DIR default has been hit, see unpackTransferPlane() function to add the direction here.");
+        }
+    }
+
+    /**
+     * @brief      Copies the local YZ plane at x=xx into buf
+     *
+     * @param[in]  xx    local x coordinate of the plane
+     * @param      buf   The buffer to fill
+     */
+    void packPlaneYZ(const int xx, T* buf)
+    {
+        for(int yy = 0; yy < ln_vec_[1]; ++yy)
+            for(int zz = 0; zz < ln_vec_[2]; ++zz)
+                buf[yy*ln_vec_[2] + zz] = point(xx, yy, zz);
+    }
+
+    /**
+     * @brief      Copies buf into the local YZ plane at x=xx
+     *
+     * @param[in]  xx    local x coordinate of the plane
+     * @param[in]  buf   The buffer to copy from
+     */
+    void unpackPlaneYZ(const int xx, const T* buf)
+    {
+        for(int yy = 0; yy < ln_vec_[1]; ++yy)
+            for(int zz = 0; zz < ln_vec_[2]; ++zz)
+                point(xx, yy, zz) = buf[yy*ln_vec_[2] + zz];
+    }
+
+    /**
+     * @brief      Copies the local XY plane at z=zz into buf
+     *
+     * @param[in]  zz    local z coordinate of the plane
+     * @param      buf   The buffer to fill
+     */
+    void packPlaneXY(const int zz, T* buf)
+    {
+        for(int yy = 0; yy < ln_vec_[1]; ++yy)
+            std::copy_n(&point(0, yy, zz), ln_vec_[0], &buf[yy*ln_vec_[0]]);
+    }
+
+    /**
+     * @brief      Copies buf into the local XY plane at z=zz
+     *
+     * @param[in]  zz    local z coordinate of the plane
+     * @param[in]  buf   The buffer to copy from
+     */
+    void unpackPlaneXY(const int zz, const T* buf)
+    {
+        for(int yy = 0; yy < ln_vec_[1]; ++yy)
+            std::copy_n(&buf[yy*ln_vec_[0]], ln_vec_[0], &point(0, yy, zz));
     }
 
 
@@ -593,9 +904,9 @@ public:
     std::pair<int, int> locate_z_no_boundaries(const int k)
     {
         int kk = 0;
-        while (kk < yTrans_.size()-1 && k >= yTrans_[kk+1]-2*(kk+1) )
+        while (kk < zTrans_.size()-1 && k >= zTrans_[kk+1]-2*(kk+1) )
             kk++;
-        return {kk, k-yTrans_[kk]};
+        return {kk, k-zTrans_[kk]};
     }
 
     /**
@@ -609,10 +920,12 @@ public:
      */
     int getLocsProc(int xx, int yy, int zz)
     {
-        int py, off;
+        int px, py, pz, off;
+        std::tie(px, off) = locate_x(xx);
         std::tie(py, off) = locate_y(yy);
+        std::tie(pz, off) = locate_z(zz);
 
-        return py;
+        return gridComm_->getRank(px, py, pz);
     }
 
     /**
@@ -626,11 +939,12 @@ public:
      */
     int getLocsProc_no_boundaries(int xx, int yy, int zz)
     {
-        int py, off;
-
+        int px, py, pz, off;
+        std::tie(px, off) = locate_x_no_boundaries(xx);
         std::tie(py, off) = locate_y_no_boundaries(yy);
+        std::tie(pz, off) = locate_z_no_boundaries(zz);
 
-        return py;
+        return gridComm_->getRank(px, py, pz);
     }
 
     /**
@@ -643,10 +957,11 @@ public:
      */
     int getLocsProc(int xx, int yy)
     {
-        int py, off;
+        int px, py, off;
+        std::tie(px, off) = locate_x(xx);
         std::tie(py, off) = locate_y(yy);
 
-        return py;
+        return gridComm_->getRank(px, py, 0);
     }
 
     /**
@@ -659,11 +974,11 @@ public:
      */
     int getLocsProc_no_boundaries(int xx, int yy)
     {
-        int py, off;
-
+        int px, py, off;
+        std::tie(px, off) = locate_x_no_boundaries(xx);
         std::tie(py, off) = locate_y_no_boundaries(yy);
 
-        return py;
+        return gridComm_->getRank(px, py, 0);
     }
 
     /**
@@ -678,11 +993,14 @@ public:
         int py, off;
         std::tie(py, off) = locate_y(j);
         std::vector<T> planeXZ(n_vec_[0]*n_vec_[2], 0.0);
-        if(gridComm_->rank() == py)
-            std::copy_n(&point(0,off,0), ln_vec_[0]*ln_vec_[2], planeXZ.data());
-
-        mpi::broadcast(*gridComm_, planeXZ, py);
-        return planeXZ;
+        // Every process in the process plane that holds y=j places its section at its location in the plane, the sections do not overlap so summing combines them
+        if(gridComm_->mypY() == py)
+            for(int zz = 0; zz < ln_vec_[2]; ++zz)
+                std::copy_n(&point(0,off,zz), ln_vec_[0], &planeXZ[(procR_C_[2]+zz)*n_vec_[0] + procR_C_[0]]);
+
+        std::vector<T> fullPlane(planeXZ.size(), 0.0);
+        mpi::all_reduce(*gridComm_, planeXZ.data(), planeXZ.size(), fullPlane.data(), std::plus<T>());
+        return fullPlane;
     }
 
     /**
@@ -697,32 +1015,13 @@ public:
         int pz, off;
         std::tie(pz, off) = locate_z(k);
         std::vector<T> planeXY(n_vec_[0]*n_vec_[1], 0.0);
-
-        if(gridComm_->rank() != pz)
-        {
-            std::vector<T> toSend(ln_vec_[1]*ln_vec_[0], 0.0);
-            for(int yy = 0; yy < ln_vec_[1]; ++yy)
-                std::copy_n( &point(0, yy, off), ln_vec_[0], &toSend[ln_vec_[0]*yy] );
-            gridComm_->send(pz, gridComm_->cantorTagGen(gridComm_->rank(), pz, 2, 0), toSend);
-        }
-        else
-        {
+        if(gridComm_->mypZ() == pz)
             for(int yy = 0; yy < ln_vec_[1]; ++yy)
-                std::copy_n( &point(0, yy, off), ln_vec_[0], &planeXY[ln_vec_[0]*yy] );
-            int spot = ln_vec_[0]*ln_vec_[1];
-            for(int ii = 0; ii < gridComm_->size(); ii ++)
-            {
-                if(ii != pz )
-                {
-                    std::vector<T> tempVec;
-                    gridComm_->recv(ii, gridComm_->cantorTagGen(ii, gridComm_->rank(), 2, 0), tempVec);
-                    std::copy_n( tempVec.data(), tempVec.size(), &planeXY[spot] );
-                    spot += tempVec.size();
-                }
-            }
-        }
-        mpi::broadcast(*gridComm_, planeXY, pz);
-        return planeXY;
+                std::copy_n(&point(0,yy,off), ln_vec_[0], &planeXY[(procR_C_[1]+yy)*n_vec_[0] + procR_C_[0]]);
+
+        std::vector<T> fullPlane(planeXY.size(), 0.0);
+        mpi::all_reduce(*gridComm_, planeXY.data(), planeXY.size(), fullPlane.data(), std::plus<T>());
+        return fullPlane;
     }
 
     /**
@@ -734,48 +1033,17 @@ public:
      */
     std::vector<T> getPlaneYZ(const int i)
     {
-        gridComm_->barrier();
         int px, off;
         std::tie(px, off) = locate_x(i);
         std::vector<T> planeYZ(n_vec_[1]*n_vec_[2], 0.0);
-
-        gridComm_->barrier();
-        if(gridComm_->rank() != px)
-        {
-            // gridComm_->barrier();
-            std::vector<T> toSend(ln_vec_[1]*ln_vec_[2], 0.0);
-            // gridComm_->barrier();
+        if(gridComm_->mypX() == px)
             for(int yy = 0; yy < ln_vec_[1]; ++yy)
                 for(int zz = 0; zz < ln_vec_[2]; ++zz)
-                    toSend[ln_vec_[2]*yy + zz] = point(off, yy, zz);
-            // gridComm_->barrier();
-            gridComm_->send(px, gridComm_->cantorTagGen(gridComm_->rank(), px, 2, 0), toSend);
-            // gridComm_->barrier();
-        }
-        else
-        {
-            // gridComm_->barrier();
-            for(int yy = 0; yy < ln_vec_[1]; ++yy)
-                for(int zz = 0; zz < ln_vec_[2]; ++zz)
-                    planeYZ[ln_vec_[2]*yy+zz] = point(off, yy, zz);
-            // gridComm_->barrier();
-            int spot = ln_vec_[2]*ln_vec_[1];
-            for(int ii = 0; ii < gridComm_->size(); ii ++)
-            {
-                if(ii != px )
-                {
-                    std::vector<T> tempVec;
-                    gridComm_->recv(ii, gridComm_->cantorTagGen(ii, gridComm_->rank(), 2, 0), tempVec);
-                    std::copy_n(tempVec.begin(), tempVec.size(), &planeYZ[spot]);
-                    spot += tempVec.size();
-                }
-            }
-            // gridComm_->barrier();
-        }
-        gridComm_->barrier();
-        mpi::broadcast(*gridComm_, planeYZ, px);
-        gridComm_->barrier();
-        return planeYZ;
+                    planeYZ[(procR_C_[1]+yy)*n_vec_[2] + procR_C_[2]+zz] = point(off, yy, zz);
+
+        std::vector<T> fullPlane(planeYZ.size(), 0.0);
+        mpi::all_reduce(*gridComm_, planeYZ.data(), planeYZ.size(), fullPlane.data(), std::plus<T>());
+        return fullPlane;
     }
 
     template <typename U> friend std::ostream &operator<<(std::ostream &out, const parallelGrid <U> &o);
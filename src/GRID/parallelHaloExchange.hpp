@@ -0,0 +1,268 @@
+#ifndef FDTD_PARALLELHALOEXCHANGE
+#define FDTD_PARALLELHALOEXCHANGE
+
+#include <GRID/parallelGrid.hpp>
+
+/**
+ * @brief      Exchanges the transfer regions of several grids with the same layout in one message per neighboring process
+ * @details    The transfer planes of every grid are packed back to back into one buffer for each neighbor, so a half step needs one send and one receive per neighbor instead of one per field component. The buffers and neighbors never change, so the sends and receives are persistent requests that are only started and waited on each half step.
+ * With shared memory on, the send buffers for neighbors on the same node are placed in an MPI-3 shared memory window and the neighbors unpack the planes directly from them, so only an empty message is passed to say the planes are packed. The shared buffers alternate between two copies: a process packs a copy again only after its next exchange with the neighbor finished, and the neighbor only starts that exchange after it is done reading the copy.
+ */
+template <typename T>
+class parallelHaloExchange
+{
+protected:
+    std::shared_ptr<mpiInterface> gridComm_; //!< The communicator for the processes that are storing the grids
+    std::vector<std::shared_ptr<parallelGrid<T>>> grids_; //!< The grids being exchanged
+
+    std::array<int,6> procNeigh_; //!< The process next to the current process in each PROC_DIR, -1 for none
+    std::array<int,6> sendTag_; //!< Tags used for sending data to the neighboring process in each PROC_DIR
+    std::array<int,6> recvTag_; //!< Tags used for receiving data from the neighboring process in each PROC_DIR
+
+    std::array<std::vector<T>, 6> sendBuf_; //!< Buffers storing the packed transfer planes of all grids sent in each PROC_DIR
+    std::array<std::vector<T>, 6> recvBuf_; //!< Buffers storing the packed transfer planes of all grids received from each PROC_DIR
+
+    persistentRequests<T> reqs_; //!< The persistent sends and receives, made at the first exchange after the last grid was added
+    int exchangeID_; //!< Separates the tags of different exchanges
+    bool pending_; //!< True if the exchange was started and not yet finished
+    bool ready_; //!< True if the requests (and the shared memory window) match the current grids
+    double waitTime_; //!< Total wall time spent waiting for the exchange to finish (used by the load balancer)
+
+    bool useShm_; //!< True if neighbors on the same node exchange through a shared memory window
+    MPI_Win win_; //!< The shared memory window holding the send buffers to neighbors on the same node (MPI_WIN_NULL if not used)
+    std::array<bool,6> shmNeigh_; //!< True if the neighbor in each PROC_DIR exchanges through the window
+    std::array<std::array<T*,6>,2> shmSend_; //!< The two copies of the send buffer in each PROC_DIR in this process's part of the window
+    std::array<std::array<const T*,6>,2> shmRecv_; //!< The two copies of the neighbor's send buffer holding the planes for this process in each PROC_DIR
+    int parity_; //!< Which copy of the shared buffers the current exchange uses
+
+    /**
+     * @brief      Makes the persistent requests and the shared memory window for the current grids, must be called by all processes on the node
+     */
+    void setup()
+    {
+        reqs_.clear();
+        freeWindow();
+        shmNeigh_.fill(false);
+        // The window is made over the node communicator, so it can only be used once that is set up
+        if(useShm_ && gridComm_->nodeRank(gridComm_->rank() ) != -1)
+        {
+            for(int dd = 0; dd < procNeigh_.size(); ++dd)
+                shmNeigh_[dd] = procNeigh_[dd] != -1 && gridComm_->nodeRank(procNeigh_[dd]) != -1;
+            setupWindow();
+        }
+        for(int dd = 0; dd < procNeigh_.size(); ++dd)
+        {
+            if(procNeigh_[dd] == -1)
+                continue;
+            // Neighbors on the node only need to know the planes are packed
+            int nSend = shmNeigh_[dd] ? 0 : sendBuf_[dd].size();
+            int nRecv = shmNeigh_[dd] ? 0 : recvBuf_[dd].size();
+            reqs_.addSend(sendBuf_[dd].data(), nSend, procNeigh_[dd], sendTag_[dd]);
+            reqs_.addRecv(recvBuf_[dd].data(), nRecv, procNeigh_[dd], recvTag_[dd]);
+        }
+        parity_ = 0;
+        ready_ = true;
+    }
+
+    /**
+     * @brief      Allocates two copies of the send buffers to neighbors on the node in a shared memory window and finds the neighbors' send buffers
+     */
+    void setupWindow()
+    {
+        MPI_Comm node = static_cast<MPI_Comm>(gridComm_->nodeComm() );
+        std::array<long long,7> offsets;
+        offsets[6] = 0;
+        for(int dd = 0; dd < 6; ++dd)
+        {
+            offsets[dd] = offsets[6];
+            offsets[6] += shmNeigh_[dd] ? sendBuf_[dd].size() : 0;
+        }
+        // Each part of the window is allocated separately so it stays in the memory closest to its process
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        T* base = nullptr;
+        MPI_Win_allocate_shared(static_cast<MPI_Aint>(2 * offsets[6] * sizeof(T) ), sizeof(T), info, node, &base, &win_);
+        MPI_Info_free(&info);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+        for(int pp = 0; pp < 2; ++pp)
+            for(int dd = 0; dd < 6; ++dd)
+                shmSend_[pp][dd] = base + pp*offsets[6] + offsets[dd];
+
+        int nodeSize = 0;
+        MPI_Comm_size(node, &nodeSize);
+        std::vector<long long> allOffsets(7*nodeSize, 0);
+        MPI_Allgather(offsets.data(), 7, MPI_LONG_LONG, allOffsets.data(), 7, MPI_LONG_LONG, node);
+        for(int dd = 0; dd < 6; ++dd)
+        {
+            if(!shmNeigh_[dd])
+                continue;
+            int nr = gridComm_->nodeRank(procNeigh_[dd]);
+            MPI_Aint sz;
+            int dispUnit;
+            T* neighBase = nullptr;
+            MPI_Win_shared_query(win_, nr, &sz, &dispUnit, &neighBase);
+            // The neighbor sends to this process in the opposite direction
+            int od = static_cast<int>(parallelGrid<T>::oppositeDir(static_cast<PROC_DIR>(dd) ) );
+            for(int pp = 0; pp < 2; ++pp)
+                shmRecv_[pp][dd] = neighBase + pp*allOffsets[7*nr+6] + allOffsets[7*nr+od];
+        }
+    }
+
+    /**
+     * @brief      Frees the shared memory window
+     */
+    void freeWindow()
+    {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if(win_ != MPI_WIN_NULL && !finalized)
+        {
+            MPI_Win_unlock_all(win_);
+            MPI_Win_free(&win_);
+        }
+        win_ = MPI_WIN_NULL;
+    }
+
+public:
+    /**
+     * @brief      Constructs an empty exchange
+     *
+     * @param[in]  gridComm    The mpiInterface for communication
+     * @param[in]  exchangeID  Index used to keep the message tags of different exchanges apart (0 or 1)
+     * @param[in]  useShm      If true neighbors on the same node exchange through a shared memory window (the node communicator of gridComm must be set up)
+     */
+    parallelHaloExchange(std::shared_ptr<mpiInterface> gridComm, int exchangeID, bool useShm=false) :
+        gridComm_(gridComm),
+        procNeigh_({{-1, -1, -1, -1, -1, -1}}),
+        sendTag_({{-1, -1, -1, -1, -1, -1}}),
+        recvTag_({{-1, -1, -1, -1, -1, -1}}),
+        reqs_(gridComm),
+        exchangeID_(exchangeID),
+        pending_(false),
+        ready_(false),
+        waitTime_(0.0),
+        useShm_(useShm),
+        win_(MPI_WIN_NULL),
+        shmNeigh_({{false, false, false, false, false, false}}),
+        parity_(0)
+    {}
+
+    parallelHaloExchange(const parallelHaloExchange&) = delete;
+    parallelHaloExchange& operator=(const parallelHaloExchange&) = delete;
+
+    ~parallelHaloExchange()
+    {
+        freeWindow();
+    }
+
+    /**
+     * @brief      Adds a grid to the exchange
+     *
+     * @param[in]  grid  The grid
+     */
+    void addGrid(std::shared_ptr<parallelGrid<T>> grid)
+    {
+        if(grids_.size() == 0)
+        {
+            procNeigh_ = grid->procNeigh();
+            for(int dd = 0; dd < procNeigh_.size(); ++dd)
+            {
+                if(procNeigh_[dd] == -1)
+                    continue;
+                sendTag_[dd] = gridComm_->cantorTagGen(gridComm_->rank(), procNeigh_[dd], 12, 6*exchangeID_ + dd);
+                recvTag_[dd] = gridComm_->cantorTagGen(procNeigh_[dd], gridComm_->rank(), 12, 6*exchangeID_ + static_cast<int>(parallelGrid<T>::oppositeDir(static_cast<PROC_DIR>(dd) ) ) );
+            }
+        }
+        else if(grid->procNeigh() != procNeigh_)
+        {
+            throw std::logic_error("All grids in a parallelHaloExchange need the same process layout");
+        }
+        grids_.push_back(grid);
+        // The buffers are resized so the requests are remade at the next exchange
+        ready_ = false;
+        for(int dd = 0; dd < procNeigh_.size(); ++dd)
+        {
+            if(procNeigh_[dd] == -1)
+                continue;
+            sendBuf_[dd].resize(sendBuf_[dd].size() + grid->transferPlaneSize(static_cast<PROC_DIR>(dd) ), 0.0);
+            recvBuf_[dd].resize(recvBuf_[dd].size() + grid->transferPlaneSize(static_cast<PROC_DIR>(dd) ), 0.0);
+        }
+    }
+
+    /**
+     * @brief      Packs the transfer planes of all grids and posts one send and one receive per neighboring process
+     * @details    All faces are sent at once, so the edges and corners of the transfer regions are not passed to the diagonal neighbors. The Yee updates only use points along the axes so they never need them.
+     */
+    void start()
+    {
+        if(grids_.size() == 0)
+            return;
+        if(!ready_)
+            setup();
+        for(int dd = 0; dd < procNeigh_.size(); ++dd)
+        {
+            if(procNeigh_[dd] == -1)
+                continue;
+            T* buf = shmNeigh_[dd] ? shmSend_[parity_][dd] : sendBuf_[dd].data();
+            for(auto& grid : grids_)
+            {
+                grid->packTransferPlane(static_cast<PROC_DIR>(dd), buf);
+                buf += grid->transferPlaneSize(static_cast<PROC_DIR>(dd) );
+            }
+        }
+        // The packed planes have to be visible to the other processes on the node before they are told to read them
+        if(win_ != MPI_WIN_NULL)
+            MPI_Win_sync(win_);
+        reqs_.start(0, reqs_.size() );
+        pending_ = true;
+    }
+
+    /**
+     * @brief      Waits for the exchange posted by start and unpacks the received planes into the transfer regions of all grids
+     */
+    void finish()
+    {
+        if(!pending_)
+            return;
+        double waitStart = MPI_Wtime();
+        reqs_.wait(0, reqs_.size() );
+        waitTime_ += MPI_Wtime() - waitStart;
+        if(win_ != MPI_WIN_NULL)
+            MPI_Win_sync(win_);
+        for(int dd = 0; dd < procNeigh_.size(); ++dd)
+        {
+            if(procNeigh_[dd] == -1)
+                continue;
+            const T* buf = shmNeigh_[dd] ? shmRecv_[parity_][dd] : recvBuf_[dd].data();
+            for(auto& grid : grids_)
+            {
+                grid->unpackTransferPlane(static_cast<PROC_DIR>(dd), buf);
+                buf += grid->transferPlaneSize(static_cast<PROC_DIR>(dd) );
+            }
+        }
+        parity_ = 1 - parity_;
+        pending_ = false;
+    }
+
+    /**
+     * @brief      Exchanges the transfer regions and waits for the exchange to finish
+     */
+    void transferDat()
+    {
+        start();
+        finish();
+    }
+
+    /**
+     * @return     The number of grids in the exchange
+     */
+    inline int nGrids() {return grids_.size();}
+
+    /**
+     * @return     The total wall time spent waiting for the exchange to finish
+     */
+    inline double waitTime() {return waitTime_;}
+};
+
+#endif
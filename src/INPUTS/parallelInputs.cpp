@@ -5,6 +5,14 @@ parallelProgramInputs::parallelProgramInputs(boost::property_tree::ptree IP,std:
     pol_(string2pol(IP.get<std::string>("CompCell.pol") ) ),
     filename_(fn),
     res_(IP.get<int>("CompCell.res") ),
+    nThreads_(IP.get<int>("CompCell.threads", 1) ),
+    procGrid_( as_ptArr<int>( IP, "CompCell.procGrid", 0) ),
+    reorderRanks_(IP.get<bool>("CompCell.reorderRanks", true) ),
+    timeTile_(IP.get<int>("CompCell.timeTile", 1) ),
+    tileRows_(IP.get<int>("CompCell.tileRows", 8) ),
+    rebalanceInterval_(IP.get<int>("CompCell.rebalanceInterval", 0) ),
+    rebalanceThreshold_(IP.get<double>("CompCell.rebalanceThreshold", 0.1) ),
+    resumeOutput_(false),
     size_( as_ptArr<double>( IP, "CompCell.size") ),
     courant_(IP.get<double>("CompCell.courant", 0.5) ),
     a_(IP.get<double>("CompCell.a",1e-7) ),
@@ -12,6 +20,16 @@ parallelProgramInputs::parallelProgramInputs(boost::property_tree::ptree IP,std:
     I0_(IP.get<double>("CompCell.I0", a_ * EPS0 * SPEED_OF_LIGHT) ),
     cplxFields_(false),
     saveFreqField_(false),
+    singlePrec_(string2singlePrec(IP.get<std::string>("CompCell.precision", "double") ) ),
+    curlKernel_(string2curlKernel(IP.get<std::string>("CompCell.curlKernel", "blas") ) ),
+    runLengthReport_(IP.get<bool>("CompCell.runLengthReport", false) ),
+    calibrateCosts_(string2calibrateCosts(IP.get<std::string>("CompCell.costModel", "static") ) ),
+    costProfile_(IP.get<std::string>("CompCell.costProfile", "") ),
+    sharedHalo_(IP.get<bool>("CompCell.sharedMemHalo", false) ),
+    progressThread_(IP.get<bool>("CompCell.progressThread", false) ),
+    progressInterval_(IP.get<int>("CompCell.progressInterval", 10) ),
+    tfsfTable_(IP.get<bool>("CompCell.tfsfTable", false) ),
+    tfsfTableCache_(IP.get<std::string>("CompCell.tfsfTableCache", "") ),
     k_point_( std::array<double,3>({0,0,0} ) ),
     // Initialize the PML parameters
     pmlAMax_( IP.get<double>("PML.aMax",0.25) ),
@@ -73,6 +91,31 @@ parallelProgramInputs::parallelProgramInputs(boost::property_tree::ptree IP,std:
     std::array<double,3> pmlThickness = as_ptArr<double>( IP, "PML.thickness");
     for(int ii = 0; ii < 3; ++ii)
         pmlThickness_[ii] = find_pt(pmlThickness[ii]);
+    if(nThreads_ < 1)
+        throw std::logic_error("The number of threads per process must be at least 1");
+    if(timeTile_ < 1 || tileRows_ < 1)
+        throw std::logic_error("CompCell.timeTile and CompCell.tileRows must be at least 1");
+    if(rebalanceInterval_ < 0 || rebalanceThreshold_ < 0.0)
+        throw std::logic_error("CompCell.rebalanceInterval and CompCell.rebalanceThreshold can not be negative");
+    if(progressInterval_ < 0)
+        throw std::logic_error("CompCell.progressInterval can not be negative");
+#ifndef _OPENMP
+    if(nThreads_ > 1)
+        throw std::logic_error("Running with more than one thread per process requires building with OpenMP (--enable-openmp)");
+#endif
+    // Periodic boundaries are applied locally in the x and z directions and 2D cells only have one z plane so those directions can't be split up
+    if(periodic_ && (procGrid_[0] > 1 || procGrid_[2] > 1) )
+        throw std::logic_error("Periodic boundary conditions require the process grid to only be split in the y direction");
+    if(size_[2] == 0 && procGrid_[2] > 1)
+        throw std::logic_error("2D calculations can not split the process grid in the z direction");
+    // Directions that can't be split are not determined automatically
+    if(procGrid_[0] != 0 || procGrid_[1] != 0 || procGrid_[2] != 0)
+    {
+        if(size_[2] == 0 || periodic_)
+            procGrid_[2] = std::max(procGrid_[2], 1);
+        if(periodic_)
+            procGrid_[0] = std::max(procGrid_[0], 1);
+    }
     // If using PBC and not normal k point use complex fields
     if(periodic_)
         for(int kk = 0; kk < k_point_.size(); kk++)
@@ -613,6 +656,42 @@ GRIDOUTTYPE parallelProgramInputs::string2GRIDOUTTYPE (std::string t)
     else
         throw std::logic_error( t + " is not a valid GRIDOUTTYPE type");
 }
+CURLKERNEL parallelProgramInputs::string2curlKernel(std::string k)
+{
+    if((k.compare("blas") == 0) || (k.compare("BLAS") == 0))
+        return CURLKERNEL::BLAS;
+    else if((k.compare("fused") == 0) || (k.compare("FUSED") == 0))
+        return CURLKERNEL::FUSED;
+    else if((k.compare("plan") == 0) || (k.compare("PLAN") == 0))
+        return CURLKERNEL::PLAN;
+    else if((k.compare("cell") == 0) || (k.compare("CELL") == 0))
+        return CURLKERNEL::CELL;
+    else if((k.compare("simd") == 0) || (k.compare("SIMD") == 0))
+        return CURLKERNEL::SIMD;
+    else
+        throw std::logic_error("The curl kernel type " + k + " is undefined. Use blas, fused, plan, cell, or simd.");
+}
+
+bool parallelProgramInputs::string2singlePrec(std::string p)
+{
+    if((p.compare("double") == 0) || (p.compare("DOUBLE") == 0))
+        return false;
+    else if((p.compare("single") == 0) || (p.compare("SINGLE") == 0) || (p.compare("float") == 0) || (p.compare("FLOAT") == 0))
+        return true;
+    else
+        throw std::logic_error("The field precision " + p + " is undefined. Use double or single.");
+}
+
+bool parallelProgramInputs::string2calibrateCosts(std::string m)
+{
+    if((m.compare("static") == 0) || (m.compare("STATIC") == 0))
+        return false;
+    else if((m.compare("calibrate") == 0) || (m.compare("CALIBRATE") == 0))
+        return true;
+    else
+        throw std::logic_error("The cost model " + m + " is undefined. Use static or calibrate.");
+}
+
 DIRECTION parallelProgramInputs::string2dir(std::string dir)
 {
     if((dir.compare("x") == 0) || (dir.compare("X") == 0))
@@ -722,6 +801,16 @@ PLSSHAPE parallelProgramInputs::string2prof(std::string p)
         throw std::logic_error("Pulse shape undefined");
 }
 
+POLETYPE parallelProgramInputs::string2poleType(std::string p)
+{
+    if(p.compare("lorentz") == 0)
+        return POLETYPE::LORENTZ;
+    else if(p.compare("debye") == 0)
+        return POLETYPE::DEBYE;
+    else
+        throw std::logic_error("Pole type undefined");
+}
+
 std::shared_ptr<Obj> parallelProgramInputs::ptreeToObject(boost::property_tree::ptree::value_type &iter)
 {
     //  Get information common amongst all objects
@@ -735,22 +824,27 @@ std::shared_ptr<Obj> parallelProgramInputs::ptreeToObject(boost::property_tree::
     std::vector<double> mater;
     std::vector<double> chiMater;
     std::vector<double> magMater;
+    std::vector<POLETYPE> poleTypes;
+    std::vector<POLETYPE> magPoleTypes;
     if(material.compare("custom") == 0)
     {
+        // Debye poles use sigma as the change in permittivity and omega as the relaxation rate 1/(2 pi tau), gamma is not used
         mater.push_back(iter.second.get<double>("eps",1.00));
         boost::property_tree::ptree& pols = iter.second.get_child("pols");
         for(auto& iter2 : pols)
         {
+            poleTypes.push_back(string2poleType(iter2.second.get<std::string>("type", "lorentz") ) );
             mater.push_back(iter2.second.get<double>("sigma"));
-            mater.push_back(iter2.second.get<double>("gamma")*M_PI);
+            mater.push_back(iter2.second.get<double>("gamma", 0.0)*M_PI);
             mater.push_back(iter2.second.get<double>("omega")*2*M_PI);
         }
         magMater.push_back( iter.second.get<double>("mu", 0.0) );
         boost::property_tree::ptree& magPols = iter.second.get_child("magPols");
         for(auto& iter2 : magPols)
         {
+            magPoleTypes.push_back(string2poleType(iter2.second.get<std::string>("type", "lorentz") ) );
             magMater.push_back(iter2.second.get<double>("sigma"));
-            magMater.push_back(iter2.second.get<double>("gamma")*M_PI);
+            magMater.push_back(iter2.second.get<double>("gamma", 0.0)*M_PI);
             magMater.push_back(iter2.second.get<double>("omega")*2*M_PI);
         }
     }
@@ -849,6 +943,11 @@ std::shared_ptr<Obj> parallelProgramInputs::ptreeToObject(boost::property_tree::
             throw std::logic_error("A shape in the ObjectList is not defined in the code");
         break;
     }
+    if(material.compare("custom") == 0)
+    {
+        out->poleType() = poleTypes;
+        out->magPoleType() = magPoleTypes;
+    }
     return out;
 }
 
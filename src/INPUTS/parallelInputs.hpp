@@ -4,6 +4,7 @@
 #include <src/OBJECTS/Obj.hpp>
 #include <src/UTIL/FDTD_consts.hpp>
 #include <src/UTIL/dielectric_params.hpp>
+#include <src/MPI/parallelCostModel.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -31,6 +32,14 @@ public:
 
     std::string filename_; //!< filename of the input file
     int res_; //!< number of grid points per unit length
+    int nThreads_; //!< number of threads each process uses for the field updates
+    std::array<int,3> procGrid_; //!< number of processes in each direction, 0 means determined from the number of processes
+    bool reorderRanks_; //!< if true renumber the processes so neighboring slabs are on the same node before laying out the process grid
+    int timeTile_; //!< maximum number of time steps advanced at once by the temporally blocked update (1 steps one at a time)
+    int tileRows_; //!< number of y rows in each slab of the temporally blocked update
+    int rebalanceInterval_; //!< number of time steps between checks of the measured load balance (0 turns runtime rebalancing off)
+    double rebalanceThreshold_; //!< relative excess of the slowest process row over the average that triggers moving the y process boundaries
+    bool resumeOutput_; //!< true if the propagator being built continues a run, so detectors append to their files (set by the load balancer, not read from the input file)
 
     double courant_; //!< Courant factor of the cell
     double a_; //!< the unit length of the calculations
@@ -39,6 +48,18 @@ public:
 
     bool cplxFields_; //!< if true use complex fields
     bool saveFreqField_; //!< if true save the flux fields
+    bool singlePrec_; //!< if true store the fields in single precision (the frequency detectors still accumulate in double precision)
+
+    CURLKERNEL curlKernel_; //!< which kernels to use for the curl updates (BLAS axpy calls, fused single pass loops, fused loops over compiled update plans, compiled plans with whole rows and per-cell prefactors, or hand vectorized kernels picked for the CPU at run time); all but BLAS also use the fused single pass PML and dispersive updates
+    bool runLengthReport_; //!< if true print the run length statistics of the update lists
+    bool calibrateCosts_; //!< if true time the update kernels at startup (or read them from costProfile_) to get the point costs used to split up the cell
+    std::string costProfile_; //!< file the calibrated point costs are read from if it exists and saved to if not (empty to always time the kernels)
+    bool sharedHalo_; //!< if true processes on the same node exchange the field borders through an MPI shared memory window instead of messages
+    bool progressThread_; //!< if true a helper thread polls MPI so the halo exchanges progress while the fields are updated
+    int progressInterval_; //!< time between the polls of the progress thread in microseconds
+    bool tfsfTable_; //!< if true the incident fields of the TFSF surfaces are calculated for the whole run before the first step and looked up every step
+    std::string tfsfTableCache_; //!< prefix of the files the TFSF incident field tables are read from if they exist and saved to if not (empty to always calculate them)
+    parallelCostModel costModel_; //!< point costs used to weight the grid points when the cell is split up (calibrated in main, not read from the input file)
 
     std::array<int,3> pmlThickness_; //!< thickness of the PMLs in all directions
     std::array<double,3> k_point_; //!< k_point vector of the light
@@ -180,6 +201,42 @@ public:
      */
     PLSSHAPE string2prof(std::string p);
 
+    /**
+     * @brief      converts a string to POLETYPE
+     *
+     * @param[in]  p     String identifier to a POLETYPE (lorentz or debye, Drude poles are Lorentz poles with omega = 0 and are recognised when the constants are set)
+     *
+     * @return     POLETYPE from that input string
+     */
+    POLETYPE string2poleType(std::string p);
+
+    /**
+     * @brief      converts a string to CURLKERNEL
+     *
+     * @param[in]  k     String identifier to a CURLKERNEL
+     *
+     * @return     CURLKERNEL from that input string
+     */
+    CURLKERNEL string2curlKernel(std::string k);
+
+    /**
+     * @brief      converts the field precision string to a bool
+     *
+     * @param[in]  p     The field precision (single or double)
+     *
+     * @return     True if the fields are stored in single precision
+     */
+    bool string2singlePrec(std::string p);
+
+    /**
+     * @brief      converts the cost model string to a bool
+     *
+     * @param[in]  m     The cost model (static or calibrate)
+     *
+     * @return     True if the point costs are calibrated at startup
+     */
+    bool string2calibrateCosts(std::string m);
+
     /**
      * @brief      converts a string to DIRECTION
      *
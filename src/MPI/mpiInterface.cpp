@@ -1,54 +1,153 @@
 #include "mpiInterface.hpp"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <numeric>
 
-mpiInterface::mpiInterface() : boost::mpi::communicator()
+mpiInterface::mpiInterface() : mpiInterface(boost::mpi::communicator())
+{}
+
+mpiInterface::mpiInterface(const boost::mpi::communicator& comm) : boost::mpi::communicator(comm)
 {
+    // Default to splitting the cell into y lamella until setProcGrid is called
     std::tie(npArr_[0], npArr_[1], npArr_[2]) = numgrid(size());
-    if (rank() == 0)
-        std::cout << " A processor grid of dimension (" << npArr_[0] << ", " << npArr_[1] << ", " << npArr_[2] << ") will be used" << std::endl;
     mypArr_ = {0,rank(), 0};
 }
 
 
-std::tuple<int,int,int> mpiInterface::getLocxLocyLocz(std::vector<real_grid_ptr> weights) const
+void mpiInterface::setProcGrid(std::array<int,3> npArr)
 {
-    std::vector<double> yE_weights( weights[0]->y(), 0 );
-    for(auto& grid : weights)
+    if(npArr[0] < 0 || npArr[1] < 0 || npArr[2] < 0)
+        throw std::logic_error("The number of processes in each direction of the process grid must be positive");
+    int nAuto = std::count(npArr.begin(), npArr.end(), 0);
+    if(nAuto == 3)
     {
-        for(int rr = 0; rr < weights[0]->y(); rr++)
-        {
-            yE_weights[rr] += std::accumulate(&grid->point(0,rr,0), &grid->point(0,rr,0)+grid->x()*grid->z(), 0);
-        }
+        std::tie(npArr[0], npArr[1], npArr[2]) = numgrid(size());
+    }
+    else if(nAuto == 1)
+    {
+        int npSet = std::max(npArr[0], 1) * std::max(npArr[1], 1) * std::max(npArr[2], 1);
+        if(size() % npSet != 0)
+            throw std::logic_error("The number of processes is not divisible by the number of processes set in the process grid");
+        std::replace(npArr.begin(), npArr.end(), 0, size() / npSet);
     }
-    double yWeightSum_E = std::accumulate(yE_weights.begin(), yE_weights.end(), 0.0);
+    else if(nAuto != 0)
+    {
+        throw std::logic_error("Only one direction of the process grid can be determined automatically");
+    }
+    if(npArr[0]*npArr[1]*npArr[2] != size())
+        throw std::logic_error("The process grid (" + std::to_string(npArr[0]) + ", " + std::to_string(npArr[1]) + ", " + std::to_string(npArr[2]) + ") does not match the number of processes " + std::to_string(size()) );
+
+    npArr_ = npArr;
+    mypArr_[1] = rank() % npArr_[1];
+    mypArr_[0] = (rank() / npArr_[1]) % npArr_[0];
+    mypArr_[2] = rank() / (npArr_[1]*npArr_[0]);
+    if (rank() == 0)
+        std::cout << " A processor grid of dimension (" << npArr_[0] << ", " << npArr_[1] << ", " << npArr_[2] << ") will be used" << std::endl;
+}
 
-    double yWeightAvg_E = static_cast<double>(yWeightSum_E) / static_cast<double>(npArr_[1]);
+void mpiInterface::reorderByNode()
+{
+    MPI_Comm comm = static_cast<MPI_Comm>(*this);
+    // Label each node and socket by its lowest rank, so sorting by the labels keeps rank 0 first and the launch order inside each group
+    std::array<int,3> key = {{rank(), rank(), rank()}};
+    MPI_Comm node;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank(), MPI_INFO_NULL, &node);
+    MPI_Allreduce(MPI_IN_PLACE, &key[0], 1, MPI_INT, MPI_MIN, node);
+#ifdef OMPI_COMM_TYPE_SOCKET
+    MPI_Comm socket;
+    MPI_Comm_split_type(node, OMPI_COMM_TYPE_SOCKET, rank(), MPI_INFO_NULL, &socket);
+    MPI_Allreduce(MPI_IN_PLACE, &key[1], 1, MPI_INT, MPI_MIN, socket);
+    MPI_Comm_free(&socket);
+#else
+    key[1] = key[0];
+#endif
+    MPI_Comm_free(&node);
+
+    std::vector<std::array<int,3>> keys(size());
+    MPI_Allgather(key.data(), 3, MPI_INT, keys.data(), 3, MPI_INT, comm);
+    std::sort(keys.begin(), keys.end() );
+    int newRank = std::find(keys.begin(), keys.end(), key) - keys.begin();
+    int nMoved = 0;
+    for(int rr = 0; rr < size(); ++rr)
+        nMoved += (keys[rr][2] != rr) ? 1 : 0;
+    if(nMoved == 0)
+        return;
+
+    MPI_Comm ordered;
+    MPI_Comm_split(comm, 0, newRank, &ordered);
+    if(rank() == 0)
+        std::cout << " Renumbered " << nMoved << " processes to group them by node" << std::endl;
+    static_cast<boost::mpi::communicator&>(*this) = boost::mpi::communicator(ordered, boost::mpi::comm_take_ownership);
+    // The default process grid was made for the old ranks
+    mypArr_ = {0, rank(), 0};
+}
+
+void mpiInterface::setupNodeComm()
+{
+    MPI_Comm node;
+    MPI_Comm_split_type(static_cast<MPI_Comm>(*this), MPI_COMM_TYPE_SHARED, rank(), MPI_INFO_NULL, &node);
+    nodeComm_ = boost::mpi::communicator(node, boost::mpi::comm_take_ownership);
+
+    // Translate every rank into the node communicator so neighbors on the same node can be found
+    MPI_Group worldGroup, nodeGroup;
+    MPI_Comm_group(static_cast<MPI_Comm>(*this), &worldGroup);
+    MPI_Comm_group(node, &nodeGroup);
+    std::vector<int> worldRanks(size(), 0);
+    std::iota(worldRanks.begin(), worldRanks.end(), 0);
+    nodeRanks_.assign(size(), MPI_UNDEFINED);
+    MPI_Group_translate_ranks(worldGroup, size(), worldRanks.data(), nodeGroup, nodeRanks_.data() );
+    std::replace(nodeRanks_.begin(), nodeRanks_.end(), static_cast<int>(MPI_UNDEFINED), -1);
+    MPI_Group_free(&worldGroup);
+    MPI_Group_free(&nodeGroup);
+}
+
+std::pair<std::vector<int>, std::vector<int>> mpiInterface::splitWeights(const std::vector<double>& planeWeights, const int np) const
+{
+    double weightAvg = std::accumulate(planeWeights.begin(), planeWeights.end(), 0.0) / static_cast<double>(np);
     double valWeight = 0.0;
 
-    std::vector<int> yStartBound(npArr_[1], 0);
-    std::vector<int> yEndBound(npArr_[1], weights[0]->y()-1);
-    int curY = 0;
-    for(int cc = 0; cc < yEndBound.size()-1; cc++)
+    std::vector<int> startBound(np, 0);
+    std::vector<int> endBound(np, planeWeights.size()-1);
+    int cur = 0;
+    for(int cc = 0; cc < np-1; cc++)
     {
         valWeight = 0;
-        curY = yStartBound[cc];
-        while(valWeight + yE_weights[curY] / 2.0 < yWeightAvg_E )
+        cur = startBound[cc];
+        // Every process needs at least one plane so stop early enough to leave one for each of the remaining processes
+        while(cur < static_cast<int>(planeWeights.size()) - (np - cc - 1) && valWeight + planeWeights[cur] / 2.0 < weightAvg )
         {
-            valWeight += yE_weights[curY];
-            curY++;
+            valWeight += planeWeights[cur];
+            cur++;
         }
-        yEndBound[cc]     = curY-1;
-        yStartBound[cc+1] = curY;
+        if(cur == startBound[cc])
+            cur++;
+        endBound[cc]     = cur-1;
+        startBound[cc+1] = cur;
     }
+    return std::make_pair(startBound, endBound);
+}
+
+std::tuple<int,int,int> mpiInterface::getLocxLocyLocz(const planeWeightSums& weights) const
+{
+    std::vector<double> xE_weights = weights[0];
+    std::vector<double> yE_weights = weights[1];
+    std::vector<double> zE_weights = weights[2];
+    // Measured costs from the load balancer only move the y boundaries so the x and z transfer regions keep their sizes
+    if(yPlaneScale_.size() == yE_weights.size() )
+        std::transform(yE_weights.begin(), yE_weights.end(), yPlaneScale_.begin(), yE_weights.begin(), std::multiplies<double>() );
+    std::vector<int> xStartBound, xEndBound, yStartBound, yEndBound, zStartBound, zEndBound;
+    std::tie(xStartBound, xEndBound) = splitWeights(xE_weights, npArr_[0]);
+    std::tie(yStartBound, yEndBound) = splitWeights(yE_weights, npArr_[1]);
+    std::tie(zStartBound, zEndBound) = splitWeights(zE_weights, npArr_[2]);
     barrier();
-    return std::make_tuple(weights[0]->x()+2, yEndBound[mypArr_[1]] - yStartBound[mypArr_[1]] + 3, weights[0]->z()+2 );
+    return std::make_tuple(xEndBound[mypArr_[0]] - xStartBound[mypArr_[0]] + 3, yEndBound[mypArr_[1]] - yStartBound[mypArr_[1]] + 3, zEndBound[mypArr_[2]] - zStartBound[mypArr_[2]] + 3 );
 
 }
 
 std::tuple<int,int,int> mpiInterface::numroc(const int ndim, const int ncol, const int nface) const
 {
-    return std::make_tuple(ndim + 2, numroc_(ncol, 1, mypArr_[1], 0, npArr_[1]), nface + 2 );
+    return std::make_tuple(npArr_[0] == 1 ? ndim + 2 : numroc_(ndim, 1, mypArr_[0], 0, npArr_[0]), numroc_(ncol, 1, mypArr_[1], 0, npArr_[1]), npArr_[2] == 1 ? nface + 2 : numroc_(nface, 1, mypArr_[2], 0, npArr_[2]) );
 }
 
 static std::tuple<int, int, int> numgrid(int numproc)
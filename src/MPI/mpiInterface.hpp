@@ -15,6 +15,7 @@
 // const static int blocksize__ = 1 ;
 typedef std::complex<double> cplx;
 typedef std::shared_ptr<Grid<double>> real_grid_ptr;
+typedef std::array<std::vector<double>,3> planeWeightSums; //!< The summed weight of every plane normal to the x, y, and z directions
 
 extern boost::mpi::environment env;
 namespace mpi = boost::mpi;
@@ -32,6 +33,9 @@ class mpiInterface : public boost::mpi::communicator
 protected:
     std::array<int,3> npArr_; //!< array of number of processes in each direction
     std::array<int,3> mypArr_; //!< The local process's process in each direction
+    std::vector<double> yPlaneScale_; //!< Factor multiplying the weight of each y plane when the cell is split up (empty if the weights are used as they are)
+    boost::mpi::communicator nodeComm_; //!< Communicator of the processes on the same node as this one (only set up if shared memory halos are used)
+    std::vector<int> nodeRanks_; //!< Rank in nodeComm_ of every process, -1 for processes on other nodes (empty if nodeComm_ is not set up)
 
 public:
     /**
@@ -39,6 +43,13 @@ public:
      */
     mpiInterface();
 
+    /**
+     * @brief      Constructs the mpiInterface over a subset of the processes
+     *
+     * @param[in]  comm  The communicator of the processes
+     */
+    mpiInterface(const boost::mpi::communicator& comm);
+
     /**
      * @brief Accessors to npX
      * @return npX
@@ -88,6 +99,40 @@ public:
      */
     inline std::array<int,3> mypArr() {return mypArr_;}
 
+    /**
+     * @brief      Accessor to yPlaneScale_, set by the load balancer to move the y process boundaries the next time the grids are made
+     *
+     * @return     yPlaneScale_
+     */
+    inline std::vector<double>& yPlaneScale() {return yPlaneScale_;}
+
+    /**
+     * @brief      Renumbers the processes so processes on the same node (and socket if the MPI library can tell) have consecutive ranks, must be called by all processes before setProcGrid
+     * @details    Neighboring y slabs are on consecutive ranks, so with the processes grouped by node most of the halo exchanges stay inside a node even if the launcher spread the ranks over the nodes round robin. The process with rank 0 keeps rank 0.
+     */
+    void reorderByNode();
+
+    /**
+     * @brief      Makes the communicator of the processes that share memory with this one, must be called by all processes
+     */
+    void setupNodeComm();
+
+    /**
+     * @brief      Accessor to nodeComm_
+     *
+     * @return     nodeComm_
+     */
+    inline const boost::mpi::communicator& nodeComm() const {return nodeComm_;}
+
+    /**
+     * @brief      Gets the rank of a process in the communicator of the processes on this node
+     *
+     * @param[in]  proc  The rank of the process
+     *
+     * @return     The rank of proc in nodeComm_, -1 if it is on another node or nodeComm_ was not set up
+     */
+    inline int nodeRank(int proc) const {return nodeRanks_.empty() ? -1 : nodeRanks_[proc];}
+
 
     /**
      * @brief      runs numroc with some of the local parameters
@@ -100,15 +145,44 @@ public:
      */
     std::tuple<int,int, int> numroc(const int nx, const int ny, const int nz) const;
 
+    /**
+     * @brief      Sets the Cartesian process grid used to split up the cell
+     * @details    Process ranks are ordered with y the fastest index then x then z (rank = py + npY*(px + npX*pz)), so a grid of (1, size, 1) reproduces the y lamella decomposition. A single 0 entry is replaced by the number of processes needed to fill the communicator, all zeros gives (1, size, 1).
+     *
+     * @param[in]  npArr  number of processes in each direction
+     */
+    void setProcGrid(std::array<int,3> npArr);
+
+    /**
+     * @brief      Gets the rank of the process at a location in the process grid
+     *
+     * @param[in]  px    process grid coordinate in the x direction
+     * @param[in]  py    process grid coordinate in the y direction
+     * @param[in]  pz    process grid coordinate in the z direction
+     *
+     * @return     The rank of the process at (px, py, pz)
+     */
+    inline int getRank(const int px, const int py, const int pz) const { return py + npArr_[1]*(px + npArr_[0]*pz); }
+
 
     /**
      * @brief      Finds the lower, left, back corner of the processor (proc loc for Grids)
      *
-     * @param[in]  weight maps of the grids
+     * @param[in]  weights  The summed weight of every plane normal to each direction
      *
      * @return     The procLoc for the Grids
      */
-    std::tuple<int,int, int> getLocxLocyLocz(std::vector<real_grid_ptr> weights) const;
+    std::tuple<int,int, int> getLocxLocyLocz(const planeWeightSums& weights) const;
+
+    /**
+     * @brief      Splits a list of plane weights into np contiguous sections of roughly equal weight
+     *
+     * @param[in]  planeWeights  The summed weight of each plane along a direction
+     * @param[in]  np            number of processes in that direction
+     *
+     * @return     The first and last plane of each section
+     */
+    std::pair<std::vector<int>, std::vector<int>> splitWeights(const std::vector<double>& planeWeights, const int np) const;
 
     /**
      * @brief      Unique int tag generator
@@ -0,0 +1,57 @@
+#include <MPI/mpiProgressThread.hpp>
+#include <chrono>
+
+mpiProgressThread::mpiProgressThread(std::shared_ptr<mpiInterface> gridComm, int pollInterval) :
+    comm_(static_cast<MPI_Comm>(*gridComm) ),
+    pollInterval_(pollInterval),
+    polling_(false),
+    quit_(false)
+{
+    // Both threads call MPI, so the library has to allow it as long as they never do it at the same time
+    if(boost::mpi::environment::thread_level() < boost::mpi::threading::serialized)
+        throw std::logic_error("The MPI progress thread needs an MPI library that supports MPI_THREAD_SERIALIZED");
+    thread_ = std::thread(&mpiProgressThread::run, this);
+}
+
+mpiProgressThread::~mpiProgressThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        quit_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+void mpiProgressThread::run()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    while(!quit_)
+    {
+        if(!polling_)
+        {
+            cv_.wait(lock, [this]{return polling_ || quit_;});
+            continue;
+        }
+        // Probing any message enters the library's progress engine, which moves all outstanding messages
+        int flag = 0;
+        MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_, &flag, MPI_STATUS_IGNORE);
+        // Sleep with the lock released so pause never waits longer than one poll
+        cv_.wait_for(lock, std::chrono::microseconds(pollInterval_), [this]{return !polling_ || quit_;});
+    }
+}
+
+void mpiProgressThread::resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        polling_ = true;
+    }
+    cv_.notify_one();
+}
+
+void mpiProgressThread::pause()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    polling_ = false;
+}
@@ -0,0 +1,57 @@
+#ifndef FDTD_MPIPROGRESSTHREAD
+#define FDTD_MPIPROGRESSTHREAD
+
+#include <MPI/mpiInterface.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief      A helper thread that keeps the MPI library moving outstanding messages while the main thread computes
+ * @details    Many MPI libraries only move the data of a non-blocking message while the process is inside an MPI call, so a halo exchange started before the updates mostly happens in the wait after them. Between resume and pause the helper thread polls the library with MPI_Iprobe so the messages progress during the updates. The main thread makes no MPI calls between resume and pause and pause waits until the helper thread is out of MPI, so only one thread is ever inside MPI and the library only has to support MPI_THREAD_SERIALIZED. The thread takes a core while it polls, so one core per process should be left free of update threads.
+ */
+class mpiProgressThread
+{
+protected:
+    MPI_Comm comm_; //!< The communicator the polled messages are sent over
+    int pollInterval_; //!< time between polls in microseconds
+    bool polling_; //!< True between resume and pause
+    bool quit_; //!< True once the thread should exit
+    std::mutex mtx_; //!< Held by the helper thread while it is inside MPI and by the main thread while it changes polling_ or quit_
+    std::condition_variable cv_; //!< Wakes the helper thread when polling is resumed or it should exit
+    std::thread thread_; //!< The helper thread
+
+    /**
+     * @brief      The loop run by the helper thread
+     */
+    void run();
+
+public:
+    /**
+     * @brief      Starts the helper thread paused
+     *
+     * @param[in]  gridComm      The communicator the polled messages are sent over
+     * @param[in]  pollInterval  time between polls in microseconds
+     */
+    mpiProgressThread(std::shared_ptr<mpiInterface> gridComm, int pollInterval);
+
+    mpiProgressThread(const mpiProgressThread&) = delete;
+    mpiProgressThread& operator=(const mpiProgressThread&) = delete;
+
+    /**
+     * @brief      Stops and joins the helper thread
+     */
+    ~mpiProgressThread();
+
+    /**
+     * @brief      Starts polling, the main thread must not make any MPI calls until pause is called
+     */
+    void resume();
+
+    /**
+     * @brief      Stops polling and waits until the helper thread is out of MPI
+     */
+    void pause();
+};
+
+#endif
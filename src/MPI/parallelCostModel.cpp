@@ -0,0 +1,180 @@
+#include <MPI/parallelCostModel.hpp>
+#include <UTIL/FDTD_up_simd.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    const int benchPts_ = 1 << 18; //!< number of points in each benchmark array (large enough to run from memory like a real grid)
+    const int benchReps_ = 20; //!< number of times each kernel is timed, the fastest time is used
+    const int benchFreqs_ = 16; //!< number of frequencies used for the frequency detector benchmark
+
+    /**
+     * @brief      Times a kernel
+     *
+     * @param[in]  kernel  The kernel
+     * @param[in]  nOps    number of point updates (or point-frequency pairs) done by one call of the kernel
+     *
+     * @return     The fastest time per point update over all repetitions
+     */
+    template <typename F> double timeKernel(F kernel, double nOps)
+    {
+        double best = std::numeric_limits<double>::max();
+        for(int rr = 0; rr < benchReps_; ++rr)
+        {
+            double t0 = MPI_Wtime();
+            kernel();
+            best = std::min(best, MPI_Wtime() - t0);
+        }
+        return best / nOps;
+    }
+
+    /**
+     * @brief      Name of a curl kernel type for the profile file
+     *
+     * @param[in]  kernel  The curl kernel type
+     *
+     * @return     The name of the kernel type
+     */
+    std::string kernelName(CURLKERNEL kernel)
+    {
+        if(kernel == CURLKERNEL::BLAS)
+            return "blas";
+        else if(kernel == CURLKERNEL::FUSED)
+            return "fused";
+        else if(kernel == CURLKERNEL::PLAN)
+            return "plan";
+        else if(kernel == CURLKERNEL::CELL)
+            return "cell";
+        return "simd";
+    }
+}
+
+parallelCostModel::parallelCostModel() :
+    curl_(2.0),
+    pole_(3.1),
+    pml_(3.1),
+    dft_(1.0)
+{}
+
+std::array<double,4> parallelCostModel::timeKernels(CURLKERNEL kernel)
+{
+    std::vector<double> fi(benchPts_, 1.0);
+    std::vector<double> fj(benchPts_+1, 0.5);
+    std::vector<double> fk(benchPts_+1, 0.25);
+    std::vector<double> lorP(benchPts_, 0.1);
+    std::vector<double> prevLorP(benchPts_, 0.2);
+    std::vector<double> jstore(benchPts_, 0.0);
+    std::array<double,4> times;
+
+    // Curl update of one field component: the BLAS kernel makes four axpy calls, all other kernel types do one pass over the run
+    if(kernel == CURLKERNEL::BLAS)
+    {
+        times[0] = timeKernel([&]()
+            {
+                daxpy_(benchPts_,  1e-3, fj.data()  , 1, fi.data(), 1);
+                daxpy_(benchPts_, -1e-3, fj.data()+1, 1, fi.data(), 1);
+                daxpy_(benchPts_, -1e-3, fk.data()  , 1, fi.data(), 1);
+                daxpy_(benchPts_,  1e-3, fk.data()+1, 1, fi.data(), 1);
+            }, benchPts_);
+    }
+    else
+    {
+        times[0] = timeKernel([&]()
+            {
+                curlSIMD::diff2(benchPts_, 1e-3, fi.data(), fj.data(), fj.data()+1, fk.data(), fk.data()+1);
+            }, benchPts_);
+    }
+    // One Lorentz pole: the polarization update (Taflove Ch. 7) and removing the polarization from the field
+    times[1] = timeKernel([&]()
+        {
+            dcopy_(benchPts_, lorP.data(), 1, jstore.data(), 1);
+            dscal_(benchPts_, 0.5, lorP.data(), 1);
+            daxpy_(benchPts_, -0.4, prevLorP.data(), 1, lorP.data(), 1);
+            daxpy_(benchPts_, 1e-3, fi.data(), 1, lorP.data(), 1);
+            dcopy_(benchPts_, jstore.data(), 1, prevLorP.data(), 1);
+            daxpy_(benchPts_, -1e-3, lorP.data(), 1, fi.data(), 1);
+        }, benchPts_);
+    // One PML direction: the psi update and adding psi to the field
+    times[2] = timeKernel([&]()
+        {
+            dscal_(benchPts_, 0.9, lorP.data(), 1);
+            daxpy_(benchPts_,  1e-3, fj.data()  , 1, lorP.data(), 1);
+            daxpy_(benchPts_, -1e-3, fj.data()+1, 1, lorP.data(), 1);
+            daxpy_(benchPts_,  1e-3, lorP.data(), 1, fi.data(), 1);
+        }, benchPts_);
+    // Frequency detectors take the outer product of the Fourier prefactors and the field values
+    int nDFTPts = benchPts_ / benchFreqs_;
+    std::vector<cplx> fftFact(benchFreqs_, cplx(0.5, 0.5) );
+    std::vector<cplx> fIn(nDFTPts, cplx(1.0, 0.0) );
+    std::vector<cplx> outGrid(benchFreqs_*nDFTPts, cplx(0.0, 0.0) );
+    times[3] = timeKernel([&]()
+        {
+            zgerc_(benchFreqs_, nDFTPts, 1.0, fftFact.data(), 1, fIn.data(), 1, outGrid.data(), benchFreqs_);
+        }, static_cast<double>(benchFreqs_) * nDFTPts);
+    return times;
+}
+
+bool parallelCostModel::load(const std::string& fname, CURLKERNEL kernel)
+{
+    if(!boost::filesystem::exists(fname) )
+        return false;
+    boost::property_tree::ptree profile;
+    boost::property_tree::json_parser::read_json(fname, profile);
+    // A profile made for a different curl kernel does not describe this calculation
+    if(profile.get<std::string>("curlKernel", "") != kernelName(kernel) )
+        return false;
+    curl_ = profile.get<double>("curl");
+    pole_ = profile.get<double>("pole");
+    pml_  = profile.get<double>("pml");
+    dft_  = profile.get<double>("dft");
+    return true;
+}
+
+void parallelCostModel::save(const std::string& fname, CURLKERNEL kernel)
+{
+    boost::property_tree::ptree profile;
+    profile.put("curlKernel", kernelName(kernel) );
+    profile.put("curl", curl_);
+    profile.put("pole", pole_);
+    profile.put("pml" , pml_ );
+    profile.put("dft" , dft_ );
+    boost::property_tree::json_parser::write_json(fname, profile);
+}
+
+void parallelCostModel::calibrate(std::shared_ptr<mpiInterface> gridComm, CURLKERNEL kernel, const std::string& profile)
+{
+    // Only the first process reads the profile so every process gets the same costs and the same split of the cell
+    int loaded = 0;
+    if(gridComm->rank() == 0 && profile.size() > 0)
+        loaded = load(profile, kernel) ? 1 : 0;
+    mpi::broadcast(*gridComm, loaded, 0);
+    std::array<double,4> costs = {{ curl_, pole_, pml_, dft_ }};
+    if(loaded)
+    {
+        mpi::broadcast(*gridComm, costs.data(), 4, 0);
+    }
+    else
+    {
+        std::array<double,4> times = timeKernels(kernel);
+        mpi::all_reduce(*gridComm, times.data(), 4, costs.data(), std::plus<double>() );
+        // Keep the curl at its fixed cost so the calibrated weights have the same scale as the fixed ones
+        double scale = 2.0 / costs[0];
+        for(auto& cost : costs)
+            cost *= scale;
+    }
+    curl_ = costs[0];
+    pole_ = costs[1];
+    pml_  = costs[2];
+    dft_  = costs[3];
+    if(gridComm->rank() == 0)
+    {
+        if(!loaded && profile.size() > 0)
+            save(profile, kernel);
+        std::cout << (loaded ? "Read the point costs from " + profile : std::string("Measured the point costs") ) << ": curl " << curl_ << ", Lorentz pole " << pole_ << ", PML " << pml_ << ", frequency detector " << dft_ << std::endl;
+    }
+}
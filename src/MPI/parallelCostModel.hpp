@@ -0,0 +1,83 @@
+#ifndef FDTD_PARALLELCOSTMODEL
+#define FDTD_PARALLELCOSTMODEL
+
+#include <MPI/mpiInterface.hpp>
+#include <UTIL/enum.hpp>
+#include <string>
+
+/**
+ * @brief      The cost of each kind of work done at a grid point, used to weight the points when the cell is split between the processes
+ * @details    By default the costs are the fixed values the weights always used (2 for the curl of one field component, 3.1 per Lorentz pole and per PML direction, and 1 per frequency of a flux surface point). In calibration mode the curl, Lorentz pole, PML, and frequency detector kernels are timed on every process at startup, the times are averaged over all processes, and the costs are scaled so the curl stays at 2, so the weights keep the same scale but follow the relative speeds of the kernels on the machine. The measured costs can be saved to a profile file and read back by later runs instead of timing the kernels again.
+ */
+class parallelCostModel
+{
+protected:
+    double curl_; //!< cost of the curl update of one field component at one point
+    double pole_; //!< cost of one Lorentz pole at one point (the polarization update and removing it from the field)
+    double pml_; //!< cost of one PML direction at one point (the psi update and adding it to the field)
+    double dft_; //!< cost of one frequency of a frequency detector at one point
+
+    /**
+     * @brief      Times the kernels on this process
+     *
+     * @param[in]  kernel  The curl kernel type used by the calculation
+     *
+     * @return     The time per point of the curl, Lorentz pole, PML, and frequency detector kernels
+     */
+    static std::array<double,4> timeKernels(CURLKERNEL kernel);
+
+    /**
+     * @brief      Reads the costs from a profile file
+     *
+     * @param[in]  fname   The profile file name
+     * @param[in]  kernel  The curl kernel type used by the calculation
+     *
+     * @return     True if the file exists and was made with the same curl kernel type
+     */
+    bool load(const std::string& fname, CURLKERNEL kernel);
+
+    /**
+     * @brief      Writes the costs to a profile file
+     *
+     * @param[in]  fname   The profile file name
+     * @param[in]  kernel  The curl kernel type used by the calculation
+     */
+    void save(const std::string& fname, CURLKERNEL kernel);
+
+public:
+    /**
+     * @brief      Constructs the model with the fixed costs
+     */
+    parallelCostModel();
+
+    /**
+     * @brief      Sets the costs from the profile file or by timing the kernels, must be called by all processes
+     *
+     * @param[in]  gridComm  The communicator of the calculation
+     * @param[in]  kernel    The curl kernel type used by the calculation
+     * @param[in]  profile   The profile file name (empty to always time the kernels and not save them)
+     */
+    void calibrate(std::shared_ptr<mpiInterface> gridComm, CURLKERNEL kernel, const std::string& profile);
+
+    /**
+     * @return     The cost of the curl update of one field component at one point
+     */
+    inline double curl() const {return curl_;}
+
+    /**
+     * @return     The cost of one Lorentz pole at one point
+     */
+    inline double pole() const {return pole_;}
+
+    /**
+     * @return     The cost of one PML direction at one point
+     */
+    inline double pml() const {return pml_;}
+
+    /**
+     * @return     The cost of one frequency of a frequency detector at one point
+     */
+    inline double dft() const {return dft_;}
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include <MPI/parallelLoadBalancer.hpp>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+
+parallelLoadBalancer::parallelLoadBalancer(std::shared_ptr<mpiInterface> gridComm, int interval, double threshold) :
+    gridComm_(gridComm),
+    interval_(interval),
+    nSteps_(0),
+    threshold_(threshold),
+    busyTime_(0.0)
+{}
+
+void parallelLoadBalancer::addSteps(int nSteps, double wallTime, double waitTime)
+{
+    nSteps_ += nSteps;
+    busyTime_ += wallTime - waitTime;
+}
+
+bool parallelLoadBalancer::check(int yStart, int nY)
+{
+    // Every process takes the same steps so they all reach the check together
+    if(!on() || nSteps_ < interval_ || gridComm_->npY() == 1)
+        return false;
+    std::array<double,3> procDat = {{ busyTime_ / static_cast<double>(nSteps_), static_cast<double>(yStart), static_cast<double>(nY) }};
+    std::vector<double> allDat;
+    mpi::all_gather(*gridComm_, procDat.data(), 3, allDat);
+    busyTime_ = 0.0;
+    nSteps_ = 0;
+
+    // A process row in y is as slow as its slowest process since they all wait on each other
+    std::vector<double> rowCost(gridComm_->npY(), 0.0);
+    std::vector<int> rowStart(gridComm_->npY(), 0);
+    std::vector<int> rowSz(gridComm_->npY(), 0);
+    for(int rr = 0; rr < gridComm_->size(); ++rr)
+    {
+        int py = rr % gridComm_->npY();
+        rowCost[py] = std::max(rowCost[py], allDat[3*rr]);
+        rowStart[py] = static_cast<int>(allDat[3*rr+1]);
+        rowSz[py] = static_cast<int>(allDat[3*rr+2]);
+    }
+    double meanCost = std::accumulate(rowCost.begin(), rowCost.end(), 0.0) / static_cast<double>(rowCost.size() );
+    double maxCost = *std::max_element(rowCost.begin(), rowCost.end() );
+    if(meanCost <= 0.0 || maxCost / meanCost - 1.0 <= threshold_)
+        return false;
+
+    // The rows were split to have about the same weight, so scaling each plane by its row's cost relative to the average makes the weights follow the measured cost
+    std::vector<double>& planeScale = gridComm_->yPlaneScale();
+    int nPlanes = rowStart.back() + rowSz.back();
+    if(planeScale.size() != nPlanes)
+        planeScale.assign(nPlanes, 1.0);
+    for(int py = 0; py < rowCost.size(); ++py)
+        for(int yy = rowStart[py]; yy < rowStart[py] + rowSz[py]; ++yy)
+            planeScale[yy] *= rowCost[py] / meanCost;
+
+    if(gridComm_->rank() == 0)
+        std::cout << "The slowest process row takes " << maxCost / meanCost << " times the average time per step, moving the y process boundaries" << std::endl;
+    return true;
+}
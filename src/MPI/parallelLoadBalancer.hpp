@@ -0,0 +1,54 @@
+#ifndef FDTD_PARALLELLOADBALANCER
+#define FDTD_PARALLELLOADBALANCER
+
+#include <MPI/mpiInterface.hpp>
+
+/**
+ * @brief      Measures how long each process takes per time step and decides when the y process boundaries should be moved
+ * @details    The static weights only count the update calls of each point, so dispersive objects, detectors, and PMLs can make some process rows much slower than predicted. The balancer averages the time each process spends outside of the halo exchange waits, takes the slowest process of each process row in y, and if the slowest row is too far above the average it rescales the weights of the y planes in the mpiInterface so the next grids made are split by the measured cost.
+ */
+class parallelLoadBalancer
+{
+protected:
+    std::shared_ptr<mpiInterface> gridComm_; //!< The communicator of the calculation
+    int interval_; //!< number of time steps between checks (0 if the balancer is off)
+    int nSteps_; //!< number of time steps since the last check
+    double threshold_; //!< relative excess of the slowest process row over the average that triggers a rebalance
+    double busyTime_; //!< wall time spent on the time steps since the last check without the time spent waiting for halo exchanges
+
+public:
+    /**
+     * @brief      Constructs the load balancer
+     *
+     * @param[in]  gridComm   The communicator of the calculation
+     * @param[in]  interval   number of time steps between checks (0 turns the balancer off)
+     * @param[in]  threshold  relative excess of the slowest process row over the average that triggers a rebalance
+     */
+    parallelLoadBalancer(std::shared_ptr<mpiInterface> gridComm, int interval, double threshold);
+
+    /**
+     * @brief      Adds the time taken by a set of time steps
+     *
+     * @param[in]  nSteps    number of time steps taken
+     * @param[in]  wallTime  wall time the steps took
+     * @param[in]  waitTime  part of wallTime spent waiting for the halo exchanges
+     */
+    void addSteps(int nSteps, double wallTime, double waitTime);
+
+    /**
+     * @brief      Checks if the y process boundaries should be moved once enough steps were timed, must be called by all processes
+     *
+     * @param[in]  yStart  first global y plane of this process (without the transfer regions)
+     * @param[in]  nY      number of y planes of this process (without the transfer regions)
+     *
+     * @return     True if the y plane weights in the mpiInterface were changed and the grids should be remade
+     */
+    bool check(int yStart, int nY);
+
+    /**
+     * @return     True if the balancer is on
+     */
+    inline bool on() {return interval_ > 0;}
+};
+
+#endif
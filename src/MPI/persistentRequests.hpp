@@ -0,0 +1,121 @@
+#ifndef FDTD_PERSISTENTREQUESTS
+#define FDTD_PERSISTENTREQUESTS
+
+#include <MPI/mpiInterface.hpp>
+#include <mpi.h>
+
+/**
+ * @brief      MPI data type of the grid value types
+ *
+ * @tparam     T     The value type
+ */
+template <typename T> inline MPI_Datatype mpiValueType();
+template <> inline MPI_Datatype mpiValueType<double>() {return MPI_DOUBLE;}
+template <> inline MPI_Datatype mpiValueType<float>()  {return MPI_FLOAT;}
+template <> inline MPI_Datatype mpiValueType<int>()    {return MPI_INT;}
+template <> inline MPI_Datatype mpiValueType<cplx>()   {return MPI_C_DOUBLE_COMPLEX;}
+
+/**
+ * @brief      A set of persistent MPI sends and receives that always use the same buffers, partners, and tags
+ * @details    The requests are set up once with MPI_Send_init/MPI_Recv_init and then only started and waited on, so each exchange skips the request allocation and argument checks of a new isend/irecv. The buffers must stay where they are for as long as the requests exist.
+ *
+ * @tparam     T     The value type of the buffers
+ */
+template <typename T>
+class persistentRequests
+{
+protected:
+    MPI_Comm comm_; //!< The communicator the messages are sent over
+    std::vector<MPI_Request> reqs_; //!< The persistent requests
+
+public:
+    /**
+     * @brief      Constructs an empty set of requests
+     *
+     * @param[in]  gridComm  The communicator the messages are sent over
+     */
+    persistentRequests(std::shared_ptr<mpiInterface> gridComm) :
+        comm_(static_cast<MPI_Comm>(*gridComm) )
+    {}
+
+    persistentRequests(const persistentRequests&) = delete;
+    persistentRequests& operator=(const persistentRequests&) = delete;
+
+    ~persistentRequests()
+    {
+        clear();
+    }
+
+    /**
+     * @brief      Adds a send
+     *
+     * @param[in]  buf    The send buffer
+     * @param[in]  count  number of values to send
+     * @param[in]  dest   The receiving process
+     * @param[in]  tag    The message tag
+     */
+    void addSend(const T* buf, int count, int dest, int tag)
+    {
+        reqs_.push_back(MPI_REQUEST_NULL);
+        MPI_Send_init(const_cast<T*>(buf), count, mpiValueType<T>(), dest, tag, comm_, &reqs_.back() );
+    }
+
+    /**
+     * @brief      Adds a receive
+     *
+     * @param      buf    The receive buffer
+     * @param[in]  count  number of values to receive
+     * @param[in]  src    The sending process
+     * @param[in]  tag    The message tag
+     */
+    void addRecv(T* buf, int count, int src, int tag)
+    {
+        reqs_.push_back(MPI_REQUEST_NULL);
+        MPI_Recv_init(buf, count, mpiValueType<T>(), src, tag, comm_, &reqs_.back() );
+    }
+
+    /**
+     * @brief      Starts requests first to last-1
+     *
+     * @param[in]  first  The first request
+     * @param[in]  last   One past the last request
+     */
+    void start(int first, int last)
+    {
+        if(last > first)
+            MPI_Startall(last - first, reqs_.data() + first);
+    }
+
+    /**
+     * @brief      Waits for requests first to last-1 to finish
+     *
+     * @param[in]  first  The first request
+     * @param[in]  last   One past the last request
+     */
+    void wait(int first, int last)
+    {
+        if(last > first)
+            MPI_Waitall(last - first, reqs_.data() + first, MPI_STATUSES_IGNORE);
+    }
+
+    /**
+     * @brief      Frees all requests
+     */
+    void clear()
+    {
+        // Requests left after MPI was shut down can not be freed anymore
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        for(auto& req : reqs_)
+            if(!finalized && req != MPI_REQUEST_NULL)
+                MPI_Request_free(&req);
+        reqs_.clear();
+    }
+
+    /**
+     * @return     The number of requests
+     */
+    inline int size() {return reqs_.size();}
+};
+
+#endif
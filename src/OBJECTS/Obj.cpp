@@ -1,4 +1,5 @@
 #include "Obj.hpp"
+#include <limits>
 
 Obj::Obj(const Obj &o) :
     unitVec_(o.unitVec_),
@@ -11,7 +12,9 @@ Obj::Obj(const Obj &o) :
     gamma_(o.gamma_),
     magAlpha_(o.magAlpha_),
     magXi_(o.magXi_),
-    magGamma_(o.magGamma_)
+    magGamma_(o.magGamma_),
+    poleType_(o.poleType_),
+    magPoleType_(o.magPoleType_)
 {}
 
 
@@ -26,7 +29,9 @@ Obj::Obj(std::vector<double> mater, std::vector<double> magMater, std::vector<do
     gamma_(std::vector<double>((material_.size()-1)/3, 0.0)),
     magAlpha_(std::vector<double>((magMaterial_.size()-1)/3, 0.0)),
     magXi_(std::vector<double>((magMaterial_.size()-1)/3, 0.0)),
-    magGamma_(std::vector<double>((magMaterial_.size()-1)/3, 0.0))
+    magGamma_(std::vector<double>((magMaterial_.size()-1)/3, 0.0)),
+    poleType_(std::vector<POLETYPE>((material_.size()-1)/3, POLETYPE::LORENTZ)),
+    magPoleType_(std::vector<POLETYPE>((magMaterial_.size()-1)/3, POLETYPE::LORENTZ))
 {
     for(int ii = 0; ii < 3; ++ii)
     {
@@ -117,23 +122,26 @@ void Obj::setUpConsts (double dt)
 {
     // Converts Lorentzian style functions into constants that can be used for time updates based on Taflove Chapter 9
     for(int ii = 0; ii < (material_.size()-1)/3; ++ii)
-    {
-        double sig = material_[3*ii+1];
-        double gam = material_[3*ii+2];
-        double omg = material_[3*ii+3];
-        alpha_[ii] = ((2-pow(omg*dt,2.0))   / (1+gam*dt));
-           xi_[ii] = ((gam*dt -1)           / (1+gam*dt));
-        gamma_[ii] = ((sig*pow(omg*dt,2.0)) / (1+gam*dt));
-    }
+        poleConsts(material_[3*ii+1], material_[3*ii+2], material_[3*ii+3], dt, poleType_[ii], alpha_[ii], xi_[ii], gamma_[ii]);
     for(int ii = 0; ii < (magMaterial_.size()-1)/3; ++ii)
+        poleConsts(magMaterial_[3*ii+1], magMaterial_[3*ii+2], magMaterial_[3*ii+3], dt, magPoleType_[ii], magAlpha_[ii], magXi_[ii], magGamma_[ii]);
+}
+
+void Obj::poleConsts(double sig, double gam, double omg, double dt, POLETYPE& type, double& alpha, double& xi, double& gamma)
+{
+    if(type == POLETYPE::DEBYE)
     {
-        double sig = magMaterial_[3*ii+1];
-        double gam = magMaterial_[3*ii+2];
-        double omg = magMaterial_[3*ii+3];
-        magAlpha_[ii] = ((2-pow(omg*dt,2.0))   / (1+gam*dt));
-           magXi_[ii] = ((gam*dt -1)           / (1+gam*dt));
-        magGamma_[ii] = ((sig*pow(omg*dt,2.0)) / (1+gam*dt));
+        // P^{n+1} = alpha P^n + gamma E^n with omg the relaxation rate
+        alpha = ((1-omg*dt/2.0) / (1+omg*dt/2.0));
+           xi = 0.0;
+        gamma = ((sig*omg*dt)   / (1+omg*dt/2.0));
+        return;
     }
+    alpha = ((2-pow(omg*dt,2.0))   / (1+gam*dt));
+       xi = ((gam*dt -1)           / (1+gam*dt));
+    gamma = ((sig*pow(omg*dt,2.0)) / (1+gam*dt));
+    // A vanishing resonance frequency makes alpha + xi = 1 so the pole only needs its current P^{n+1} - P^n
+    type = (pow(omg*dt,2.0) < std::numeric_limits<double>::epsilon() ) ? POLETYPE::DRUDE : POLETYPE::LORENTZ;
 }
 
 bool sphere::isObj(std::array<double,3> v, double dx)
@@ -367,4 +375,78 @@ double Obj::dist(std::array<double,3> pt1, std::array<double,3> pt2)
     for(int cc = 0; cc < pt1.size(); cc ++)
         sum += pow((pt1[cc]-pt2[cc]),2);
     return sqrt(sum);
-}
\ No newline at end of file
+}
+std::array<std::array<double,3>,2> Obj::boundBox()
+{
+    double big = std::numeric_limits<double>::max();
+    return {{ {{ -big, -big, -big }}, {{ big, big, big }} }};
+}
+
+std::array<std::array<double,3>,2> Obj::orientedBoundBox(std::array<double,3> halfExt)
+{
+    // The object coordinates are v_trans = M v_cen with the rows of M stored in coordTransform_, so the corners of the box are M^-1 (+/-halfExt)
+    const std::array<double,9>& M = coordTransform_;
+    double det = M[0]*(M[4]*M[8] - M[5]*M[7]) - M[1]*(M[3]*M[8] - M[5]*M[6]) + M[2]*(M[3]*M[7] - M[4]*M[6]);
+    if(std::abs(det) < 1e-12)
+        return Obj::boundBox();
+    std::array<double,9> inv = {{
+        (M[4]*M[8] - M[5]*M[7]) / det, (M[2]*M[7] - M[1]*M[8]) / det, (M[1]*M[5] - M[2]*M[4]) / det,
+        (M[5]*M[6] - M[3]*M[8]) / det, (M[0]*M[8] - M[2]*M[6]) / det, (M[2]*M[3] - M[0]*M[5]) / det,
+        (M[3]*M[7] - M[4]*M[6]) / det, (M[1]*M[6] - M[0]*M[7]) / det, (M[0]*M[4] - M[1]*M[3]) / det }};
+    std::array<std::array<double,3>,2> box;
+    for(int dd = 0; dd < 3; ++dd)
+    {
+        double ext = 0.0;
+        for(int ii = 0; ii < 3; ++ii)
+            ext += std::abs(inv[dd*3+ii]) * halfExt[ii];
+        box[0][dd] = location_[dd] - ext;
+        box[1][dd] = location_[dd] + ext;
+    }
+    return box;
+}
+
+std::array<std::array<double,3>,2> sphere::boundBox()
+{
+    return {{ {{ location_[0]-geoParam_[0], location_[1]-geoParam_[0], location_[2]-geoParam_[0] }}, {{ location_[0]+geoParam_[0], location_[1]+geoParam_[0], location_[2]+geoParam_[0] }} }};
+}
+
+std::array<std::array<double,3>,2> hemisphere::boundBox()
+{
+    return {{ {{ location_[0]-geoParam_[0], location_[1]-geoParam_[0], location_[2]-geoParam_[0] }}, {{ location_[0]+geoParam_[0], location_[1]+geoParam_[0], location_[2]+geoParam_[0] }} }};
+}
+
+std::array<std::array<double,3>,2> block::boundBox()
+{
+    return orientedBoundBox({{ geoParam_[0]/2.0, geoParam_[1]/2.0, geoParam_[2]/2.0 }});
+}
+
+std::array<std::array<double,3>,2> rounded_block::boundBox()
+{
+    return orientedBoundBox({{ geoParam_[0]/2.0, geoParam_[1]/2.0, geoParam_[2]/2.0 }});
+}
+
+std::array<std::array<double,3>,2> ellipsoid::boundBox()
+{
+    return orientedBoundBox({{ geoParam_[0]/2.0, geoParam_[1]/2.0, geoParam_[2]/2.0 }});
+}
+
+std::array<std::array<double,3>,2> hemiellipsoid::boundBox()
+{
+    return orientedBoundBox({{ geoParam_[0]/2.0, geoParam_[1]/2.0, geoParam_[2]/2.0 }});
+}
+
+std::array<std::array<double,3>,2> cylinder::boundBox()
+{
+    return orientedBoundBox({{ geoParam_[0], geoParam_[0], geoParam_[1]/2.0 }});
+}
+
+std::array<std::array<double,3>,2> isosceles_tri_prism::boundBox()
+{
+    return orientedBoundBox({{ geoParam_[0]/2.0, geoParam_[1]/2.0, geoParam_[2]/2.0 }});
+}
+
+std::array<std::array<double,3>,2> trapezoid_prism::boundBox()
+{
+    // The wider of the two bases sets the width of the box
+    return orientedBoundBox({{ std::max(geoParam_[0], geoParam_[1])/2.0, geoParam_[2]/2.0, geoParam_[3]/2.0 }});
+}
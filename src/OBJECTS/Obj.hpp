@@ -21,9 +21,35 @@ protected:
     std::vector<double> magXi_; //!<Lorentz model pole parameter for magnetic materials (equivlant model for normal dispersive material)
     std::vector<double> magGamma_; //!<Lorentz model pole parameter for magnetic materials (equivlant model for normal dispersive material)
 
+    std::vector<POLETYPE> poleType_; //!< type of each pole (Debye poles are set by the inputs, Drude poles are recognised in setUpConsts)
+    std::vector<POLETYPE> magPoleType_; //!< type of each magnetic pole
+
 
     std::array<double,3> location_; //!< location of the center point of the object
     std::array<double,9> coordTransform_; //!< Coordinate Transform Matrix
+
+    /**
+     * @brief      Finds the axis aligned box holding a box in the object's coordinate system
+     *
+     * @param[in]  halfExt  The half widths of the box along the object's axes
+     *
+     * @return     The lower and upper corners of the box (all of space if the object's axes are degenerate)
+     */
+    std::array<std::array<double,3>,2> orientedBoundBox(std::array<double,3> halfExt);
+
+    /**
+     * @brief      Calculates the update constants of a single pole
+     *
+     * @param[in]  sig    The pole strength
+     * @param[in]  gam    The damping rate
+     * @param[in]  omg    The resonance frequency (relaxation rate for Debye poles)
+     * @param[in]  dt     The time step
+     * @param      type   The pole type (Lorentz and Drude poles are set to the type matching their constants)
+     * @param[out] alpha  The alpha constant of the pole
+     * @param[out] xi     The xi constant of the pole
+     * @param[out] gamma  The gamma constant of the pole
+     */
+    static void poleConsts(double sig, double gam, double omg, double dt, POLETYPE& type, double& alpha, double& xi, double& gamma);
 public:
 
     /**
@@ -45,7 +71,7 @@ public:
     Obj(const Obj &o);
     /**
      * @brief Calculates the dispersion parameters from physical ones
-     * @details Show equations here
+     * @details Lorentz poles use alpha = (2-(omega dt)^2)/(1+gamma dt), xi = (gamma dt-1)/(1+gamma dt), and gamma = sigma (omega dt)^2/(1+gamma dt) (Taflove ch 9). Lorentz poles with (omega dt)^2 below the machine precision are marked as Drude poles (alpha + xi = 1). Debye poles (omega is the relaxation rate 1/tau) use alpha = (1-omega dt/2)/(1+omega dt/2), xi = 0, and gamma = sigma omega dt/(1+omega dt/2).
      *
      * @param dt time step
      */
@@ -93,6 +119,15 @@ public:
      */
     inline std::vector<double>& magGamma() {return magGamma_;}
 
+    /**
+     * @return the type of each pole in the material of the object
+     */
+    inline std::vector<POLETYPE>& poleType() {return poleType_;}
+    /**
+     * @return the type of each magnetic pole in the material of the object
+     */
+    inline std::vector<POLETYPE>& magPoleType() {return magPoleType_;}
+
     /**
      * @return     return the $\eps_{\infty}$
      */
@@ -118,6 +153,13 @@ public:
      */
     virtual bool isObj(std::array<double,3> v, double dx) = 0;
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object, used to only test the points near the object
+     *
+     * @return     The lower and upper corners of the box (all of space for shapes without a box)
+     */
+    virtual std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @brief      Returns the distance between two points
      *
@@ -165,6 +207,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::SPHERE
      */
@@ -202,6 +251,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::HEMISPHERE
      */
@@ -239,6 +295,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::BLOCK
      */
@@ -278,6 +341,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::ROUNDED_BLOCK
      */
@@ -314,6 +384,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::ELLIPSOID
      */
@@ -351,6 +428,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::HEMIELLIPSOID
      */
@@ -426,6 +510,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::CYLINDER
      */
@@ -463,6 +554,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::TRIANGLE_PRISM
      */
@@ -501,6 +599,13 @@ public:
      */
     bool isObj(std::array<double,3> v, double dx);
 
+    /**
+     * @brief      Finds an axis aligned box that holds the whole object
+     *
+     * @return     The lower and upper corners of the box
+     */
+    std::array<std::array<double,3>,2> boundBox();
+
     /**
      * @return     SHAPE::TRAPEZOIDAL_PRISM
      */
@@ -15,6 +15,9 @@ struct updatePsiParams
     double cOff_; //!< the c parameter as defined in chapter 7 of Taflove, but with the opposite sign of c
     std::array<int,3> loc_; //!< the starting point of the blas operations
     std::array<int,3> locOff_; //!< the starting point of the blas operations offset by the correct value
+    int psiIdx_; //!< index of the starting point of the blas operations in the compact $\psi$ storage
+    int psiStride_; //!< stride for the blas operations in the compact $\psi$ storage
+    double Db_; //!< psi factor add on prefactor for the fused update (0.0 if the points are not added to the field)
 };
 /**
  * @brief      Parameters to update the fields using the $\psi$ fields
@@ -25,12 +28,110 @@ struct updateGridParams
     int stride_; //!< stride for blas operator
     double Db_; //!< psi factor add on prefactor
     std::array<int,3> loc_; //!< starting point of MKL operations
+    int psiIdx_; //!< index of the starting point of the MKL operations in the compact $\psi$ storage
+    int psiStride_; //!< stride for the MKL operations in the compact $\psi$ storage
+};
+
+/**
+ * @brief      Compact storage for a CPML $\psi$ field that only keeps the points inside the local PML slabs
+ * @details    $\psi$ is zero outside of the PMLs, so instead of a full copy of the field each PML slab of the process gets a box of points just large enough for the points its updates touch. The boxes use the same (y, z, x) ordering as the parallelGrids.
+ *
+ * @tparam     T     The field type
+ */
+template <typename T> class pmlPsiField
+{
+protected:
+    std::vector<T> vals_; //!< the values of all boxes back to back
+    std::vector<std::array<int,3>> lo_; //!< first local grid point of each box
+    std::vector<std::array<int,3>> sz_; //!< size of each box
+    std::vector<int> start_; //!< index of the first value of each box in vals_
+
+public:
+    /**
+     * @brief      Adds a box of points
+     *
+     * @param[in]  lo    The first local grid point in the box
+     * @param[in]  hi    One past the last local grid point in the box in each direction
+     *
+     * @return     The index of the box
+     */
+    int addBox(const std::array<int,3>& lo, const std::array<int,3>& hi)
+    {
+        lo_.push_back(lo);
+        sz_.push_back({{ hi[0]-lo[0], hi[1]-lo[1], hi[2]-lo[2] }});
+        start_.push_back(vals_.size() );
+        vals_.resize(vals_.size() + sz_.back()[0]*sz_.back()[1]*sz_.back()[2], 0.0);
+        return lo_.size() - 1;
+    }
+
+    /**
+     * @brief      Index of a local grid point in the compact storage
+     *
+     * @param[in]  box   The box the point is in
+     * @param[in]  loc   The local grid point
+     *
+     * @return     The index of the point in data()
+     */
+    inline int index(int box, const std::array<int,3>& loc) const
+    {
+        return start_[box] + ( (loc[1]-lo_[box][1])*sz_[box][2] + (loc[2]-lo_[box][2]) ) * sz_[box][0] + (loc[0]-lo_[box][0]);
+    }
+
+    /**
+     * @brief      Distance between neighboring points of a box in a direction
+     *
+     * @param[in]  box   The box
+     * @param[in]  dir   The direction (0 for x, 1 for y, 2 for z)
+     *
+     * @return     The stride in data()
+     */
+    inline int stride(int box, int dir) const
+    {
+        return dir == 0 ? 1 : dir == 2 ? sz_[box][0] : sz_[box][0]*sz_[box][2];
+    }
+
+    /**
+     * @brief      Copies the values into a grid of the full process size (the points outside the boxes are not touched)
+     *
+     * @param      grid  The grid
+     */
+    void toGrid(parallelGrid<T>& grid) const
+    {
+        for(int bb = 0; bb < lo_.size(); ++bb)
+            for(int yy = lo_[bb][1]; yy < lo_[bb][1] + sz_[bb][1]; ++yy)
+                for(int zz = lo_[bb][2]; zz < lo_[bb][2] + sz_[bb][2]; ++zz)
+                    std::copy_n(&vals_[index(bb, {{lo_[bb][0], yy, zz}})], sz_[bb][0], &grid.point(lo_[bb][0], yy, zz) );
+    }
+
+    /**
+     * @brief      Copies the values from a grid of the full process size
+     *
+     * @param[in]  grid  The grid
+     */
+    void fromGrid(const parallelGrid<T>& grid)
+    {
+        for(int bb = 0; bb < lo_.size(); ++bb)
+            for(int yy = lo_[bb][1]; yy < lo_[bb][1] + sz_[bb][1]; ++yy)
+                for(int zz = lo_[bb][2]; zz < lo_[bb][2] + sz_[bb][2]; ++zz)
+                    std::copy_n(&grid.point(lo_[bb][0], yy, zz), sz_[bb][0], &vals_[index(bb, {{lo_[bb][0], yy, zz}})]);
+    }
+
+    /**
+     * @return     Pointer to the compact storage
+     */
+    inline T* data() {return vals_.data();}
+
+    /**
+     * @return     The number of stored points
+     */
+    inline int size() const {return vals_.size();}
 };
 
 
 template <typename T> class parallelCPML
 {
     typedef std::shared_ptr<parallelGrid<T>> pgrid_ptr;
+    typedef decltype(std::real(std::declval<T>())) coef_type; //!< the fused update prefactors are used with the precision of the fields (float for float fields, double otherwise)
 protected:
     std::shared_ptr<mpiInterface> gridComm_; //!< MPI Communicator
     POLARIZATION pol_i_; //!< Polarization of the Field that the CPML is acting on
@@ -53,25 +154,34 @@ protected:
     std::vector<double> eta_eff_right_; //!< eta effective along right PML
     std::vector<double> eta_eff_front_; //!< eta effective along right PML
     std::vector<double> eta_eff_back_; //!< eta effective along right PML
-    std::function<void(std::vector<updateGridParams>&, std::vector<updatePsiParams>&, pgrid_ptr, pgrid_ptr, pgrid_ptr)> upPsi_j_; //!< update function for the $\\psi_j$ field
-    std::function<void(std::vector<updateGridParams>&, std::vector<updatePsiParams>&, pgrid_ptr, pgrid_ptr, pgrid_ptr)> upPsi_k_; //!< update function for the $\\psi_k$ field
+    std::function<void(std::vector<updateGridParams>&, std::vector<updatePsiParams>&, pgrid_ptr, T*, pgrid_ptr)> upPsi_j_; //!< update function for the $\\psi_j$ field
+    std::function<void(std::vector<updateGridParams>&, std::vector<updatePsiParams>&, pgrid_ptr, T*, pgrid_ptr)> upPsi_k_; //!< update function for the $\\psi_k$ field
+    bool fused_; //!< True if the fused update lists are used instead of the blas ones
 
 public:
     pgrid_ptr grid_i_; //!< FDTD field polarized in the i direction (E/H) is the same as it is in pol_i
     pgrid_ptr grid_j_; //!< FDTD field polarized in the j direction (E/H) is the opposite as it is in pol_i
     pgrid_ptr grid_k_; //!< FDTD field polarized in the k direction (E/H) is the opposite as it is in pol_i
-    pgrid_ptr psi_j_; //!< CPML helper field $\\psi$ polarized in the j direction
-    pgrid_ptr psi_k_; //!< CPML helper field $\\psi$ polarized in the k direction
+    std::shared_ptr<pmlPsiField<T>> psi_j_; //!< CPML helper field $\\psi$ polarized in the j direction (only stored inside the local PMLs)
+    std::shared_ptr<pmlPsiField<T>> psi_k_; //!< CPML helper field $\\psi$ polarized in the k direction (only stored inside the local PMLs)
     std::vector<updatePsiParams>  updateListPsi_j_; //!< update parameters for $\\psi_j$ field
     std::vector<updatePsiParams>  updateListPsi_k_; //!< update parameters for $\\psi_k$ field
     std::vector<updateGridParams> updateListGrid_j_; //!< update parameters for the updates in the j direction
     std::vector<updateGridParams> updateListGrid_k_; //!< update parameters for the updates in the k direction
+    std::vector<updatePsiParams>  updateListFused_j_; //!< update parameters for the fused $\\psi_j$ and grid updates
+    std::vector<updatePsiParams>  updateListFused_k_; //!< update parameters for the fused $\\psi_k$ and grid updates
+    std::vector<std::vector<updatePsiParams>>  slabListPsi_j_; //!< updateListPsi_j_ split into the y slabs of the temporally blocked update
+    std::vector<std::vector<updatePsiParams>>  slabListPsi_k_; //!< updateListPsi_k_ split into the y slabs of the temporally blocked update
+    std::vector<std::vector<updateGridParams>> slabListGrid_j_; //!< updateListGrid_j_ split into the y slabs of the temporally blocked update
+    std::vector<std::vector<updateGridParams>> slabListGrid_k_; //!< updateListGrid_k_ split into the y slabs of the temporally blocked update
+    std::vector<std::vector<updatePsiParams>>  slabListFused_j_; //!< updateListFused_j_ split into the y slabs of the temporally blocked update
+    std::vector<std::vector<updatePsiParams>>  slabListFused_k_; //!< updateListFused_k_ split into the y slabs of the temporally blocked update
 
     /**
      * @brief      { function_description }
      *
      * @param[in]  gridComm  mpi communicator
-     * @param[in]  weights   The weights
+     * @param[in]  weights   The summed weight of every plane normal to each direction
      * @param[in]  grid_i    shared pointer to grid_i (field PML is being applied to)
      * @param[in]  grid_j    shared pointer to grid_j (field polarized in the j direction of the PML; nullptr if none)
      * @param[in]  grid_k    shared pointer to grid_k (field polarized in the k direction of the PML; nullptr if none)
@@ -86,7 +196,7 @@ public:
      * @param[in]  phys_Ey   The physical ey grid
      * @param[in]  objArr    The object arr
      */
-    parallelCPML(std::shared_ptr<mpiInterface> gridComm, std::vector<real_grid_ptr> weights, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k, POLARIZATION pol_i, std::array<int,3> n_vec, double m, double ma, double aMax, std::array<double,3> d, double dt, int_pgrid_ptr physGrid, std::vector<std::shared_ptr<Obj>> objArr) :
+    parallelCPML(std::shared_ptr<mpiInterface> gridComm, const planeWeightSums& weights, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k, POLARIZATION pol_i, std::array<int,3> n_vec, double m, double ma, double aMax, std::array<double,3> d, double dt, int_pgrid_ptr physGrid, std::vector<std::shared_ptr<Obj>> objArr) :
         gridComm_(gridComm),
         pol_i_(pol_i),
         n_vec_(n_vec),
@@ -97,6 +207,7 @@ public:
         aMax_(aMax),
         d_(d),
         dt_(dt),
+        fused_(false),
         grid_i_(grid_i),
         grid_j_(grid_j),
         grid_k_(grid_k)
@@ -127,7 +238,7 @@ public:
         // In 2D z direction is assumed to be isotropic, but 3D it is not
         if(grid_k_ && (grid_i_->local_z() != 1 || j_ != DIRECTION::Z) )
         {
-            psi_j_ = std::make_shared<parallelGrid<T>>(gridComm, grid_k_->PBC(), weights, grid_k_->n_vec(), grid_k_->d() );
+            psi_j_ = std::make_shared<pmlPsiField<T>>();
         }
         else
             psi_j_ = nullptr;
@@ -135,7 +246,7 @@ public:
         // In 2D z direction is assumed to be isotropic, but in 3D it is not
         if(grid_j_ && (grid_i_->local_z() != 1 || k_ != DIRECTION::Z) )
         {
-            psi_k_ = std::make_shared<parallelGrid<T>>(gridComm, grid_j_->PBC(), weights, grid_j_->n_vec(), grid_j_->d() );
+            psi_k_ = std::make_shared<pmlPsiField<T>>();
         }
         else
             psi_k_ = nullptr;
@@ -324,15 +435,15 @@ public:
             negC = (pol_i_ == POLARIZATION::EZ || pol_i_ == POLARIZATION::EY) ? false : true;
 
             // Ey, Hx, and Hz fields have one less point in the y direction
-            if( (pol_i_ == POLARIZATION::EY || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HZ ) && gridComm_->rank() == gridComm_->size() - 1)
+            if( (pol_i_ == POLARIZATION::EY || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HZ ) && gridComm_->mypY() == gridComm_->npY() - 1)
                 (grid_i_->local_z() == 1) ? trans1FieldOff = 1 : trans2FieldOff = 1;
 
             // Ez, Hx, and Hy fields have one less point in the z direction
-            if( (pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::EZ ) )
+            if( (pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::EZ ) && gridComm_->mypZ() == gridComm_->npZ() - 1)
                 (grid_i_->local_z() == 1) ? trans2FieldOff = 1 : trans1FieldOff = 1;
 
             // PML start / Max conditions depending on where in the map they are
-            if( pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EX)
+            if( ( gridComm_->mypX() == gridComm_->npX()-1) && (pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EX) )
                 pl ? ccStart = 1 : dirMax -= 1;
         }
         else if(dir == DIRECTION::Y)
@@ -347,13 +458,13 @@ public:
             // Determines sign of the spatial derivative
             negC = (pol_i_ == POLARIZATION::EZ || pol_i_ == POLARIZATION::EX) ? false : true;
             // Ex, Hy, and Hz fields have one less point in the x direction
-            if(pol_i_ == POLARIZATION::EX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::HZ )
+            if( (pol_i_ == POLARIZATION::EX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::HZ ) && gridComm_->mypX() == gridComm_->npX() - 1)
                 trans1FieldOff = 1;
             // Ez, Hx, and Hy fields have one less point in the z direction
-            if( (pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EZ ) )
+            if( (pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EZ ) && gridComm_->mypZ() == gridComm_->npZ() - 1)
                 trans2FieldOff = 1;
             // Hx, Ey, and Hz fields all have one less point in the z direction
-            if( ( gridComm_->rank() == gridComm_->size()-1) && (pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::EY) )
+            if( ( gridComm_->mypY() == gridComm_->npY()-1) && (pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::EY) )
                 pl ? ccStart = 1 : dirMax -= 1;
         }
         else if(dir == DIRECTION::Z)
@@ -367,13 +478,13 @@ public:
             // Determines sign of the spatial derivative
             negC = (pol_i_ == POLARIZATION::EY || pol_i_ == POLARIZATION::EX) ? false : true;
             // Ex, Hy, and Hz fields have one less point in the x direction
-            if(pol_i_ == POLARIZATION::EX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::HZ )
+            if( (pol_i_ == POLARIZATION::EX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::HZ ) && gridComm_->mypX() == gridComm_->npX() - 1)
                 trans1FieldOff = 1;
             // Ey, Hx, and Hz fields have one less point in the y direction
-            if( (pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::EY ) && gridComm_->rank() == gridComm_->size() - 1)
+            if( (pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::EY ) && gridComm_->mypY() == gridComm_->npY() - 1)
                 trans2FieldOff = 1;
             // Hx, Hy, and Ez fields all have one less point in the z direction
-            if( pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EZ )
+            if( ( gridComm_->mypZ() == gridComm_->npZ()-1) && (pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EZ) )
                 pl ? ccStart = 1 : dirMax -= 1;
         }
         else
@@ -598,13 +709,13 @@ public:
         max[cor_kk] = grid_i_->ln_vec()[cor_kk]-1;
 
         // Ex, Hy, Hz fields have one less point in the x direction
-        if( cor_ii != 0 && ( pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::EX || pol_i_ == POLARIZATION::HY ) )
+        if( cor_ii != 0 && ( gridComm_->mypX() == gridComm_->npX()-1 ) && ( pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::EX || pol_i_ == POLARIZATION::HY ) )
             max[0] -= 1;
         // Hx, Ey, Hz fields have one less point in the y direction
-        if( cor_ii != 1 && ( gridComm_->rank() == gridComm_->size()-1 ) && (pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::EY) )
+        if( cor_ii != 1 && ( gridComm_->mypY() == gridComm_->npY()-1 ) && (pol_i_ == POLARIZATION::HZ || pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::EY) )
             max[1] -= 1;
         // Hx, Hy, Ez fields have one less point in the z direction
-        if( cor_ii != 2 && grid_i_->local_z() != 1 && ( pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EZ ) )
+        if( cor_ii != 2 && grid_i_->local_z() != 1 && ( gridComm_->mypZ() == gridComm_->npZ()-1 ) && ( pol_i_ == POLARIZATION::HX || pol_i_ == POLARIZATION::HY || pol_i_ == POLARIZATION::EZ ) )
             max[2] -= 1;
 
 
@@ -629,10 +740,12 @@ public:
      * @param[in]  pmlEdge  Where the PML ends
      * @param[in]  nDir     Thickness in that direction.
      * @param[in]  dirMax   How far to iterate over.
+     * @param      psi       The $\psi$ field the lists update
      * @param      psiList   The $\psi$ update list
      * @param      gridList  The grid_i update list
+     * @param      fusedList The fused $\psi$ and grid_i update list
      */
-    void fillLists(DIRECTION dir, bool pl, int startPt, int pmlEdge, int nDir, int dirMax, std::vector<updatePsiParams>& psiList, std::vector<updateGridParams>& gridList)
+    void fillLists(DIRECTION dir, bool pl, int startPt, int pmlEdge, int nDir, int dirMax, pmlPsiField<T>& psi, std::vector<updatePsiParams>& psiList, std::vector<updateGridParams>& gridList, std::vector<updatePsiParams>& fusedList)
     {
         std::vector<updatePsiParams> psiTemp;
         std::vector<updateGridParams> gridTemp;
@@ -640,6 +753,65 @@ public:
         psiTemp  = getPsiUpList (dir, pl, startPt, pmlEdge, nDir, dirMax);
         gridTemp = getGridUpList(dir, pl);
 
+        // Store $\psi$ for the box of points the lists of this PML touch
+        std::array<int,3> lo = {{ grid_i_->local_x(), grid_i_->local_y(), grid_i_->local_z() }};
+        std::array<int,3> hi = {{ 0, 0, 0 }};
+        auto addRun = [&](const std::array<int,3>& loc, int stride, int n)
+        {
+            if(n <= 0)
+                return;
+            std::array<int,3> last = loc;
+            last[strideDir(stride)] += n - 1;
+            for(int ii = 0; ii < 3; ++ii)
+            {
+                lo[ii] = std::min(lo[ii], loc[ii]);
+                hi[ii] = std::max(hi[ii], last[ii] + 1);
+            }
+        };
+        for(auto& param : psiTemp)
+            addRun(param.loc_, param.stride_, param.transSz_);
+        for(auto& param : gridTemp)
+            addRun(param.loc_, param.stride_, param.nAx_);
+        if(hi[0] <= lo[0] || hi[1] <= lo[1] || hi[2] <= lo[2])
+            return;
+        int box = psi.addBox(lo, hi);
+        for(auto& param : psiTemp)
+        {
+            param.psiIdx_ = psi.index(box, param.loc_);
+            param.psiStride_ = psi.stride(box, strideDir(param.stride_) );
+        }
+        for(auto& param : gridTemp)
+        {
+            param.psiIdx_ = psi.index(box, param.loc_);
+            param.psiStride_ = psi.stride(box, strideDir(param.stride_) );
+        }
+
+        // Split the $\psi$ runs into pieces whose points are or are not added to grid_i, so the fused update can add each point right after updating it. The grid runs also cover points no $\psi$ run updates, but $\psi$ stays zero there so they are dropped.
+        std::vector<bool> added(psi.size(), false);
+        for(auto& param : gridTemp)
+            for(int ii = 0; ii < param.nAx_; ++ii)
+                added[param.psiIdx_ + ii*param.psiStride_] = true;
+        double Db = gridTemp.empty() ? 0.0 : gridTemp.front().Db_;
+        for(auto& param : psiTemp)
+        {
+            int ii = 0;
+            while(ii < param.transSz_)
+            {
+                bool add = added[param.psiIdx_ + ii*param.psiStride_];
+                int jj = ii;
+                while(jj < param.transSz_ && added[param.psiIdx_ + jj*param.psiStride_] == add)
+                    ++jj;
+                updatePsiParams piece = param;
+                piece.transSz_ = jj - ii;
+                piece.loc_[strideDir(param.stride_)] += ii;
+                piece.locOff_[strideDir(param.stride_)] += ii;
+                piece.psiIdx_ += ii*param.psiStride_;
+                piece.Db_ = add ? Db : 0.0;
+                fusedList.push_back(piece);
+                ii = jj;
+            }
+        }
+
         psiList.reserve(psiList.size() + psiTemp.size());
         psiList.insert(psiList.end(), psiTemp.begin(), psiTemp.end());
         gridList.reserve(gridList.size() + gridTemp.size());
@@ -661,19 +833,211 @@ public:
     {
         if(ln_pml > 0 && i_ != dir)
         {
-            if(grid_k_ && j_ == dir)
-                fillLists( dir, pl, startPt, pmlEdge, nDir, dirMax, updateListPsi_j_, updateListGrid_j_);
-            else if(grid_j_ && k_ == dir)
-                fillLists( dir, pl, startPt, pmlEdge, nDir, dirMax, updateListPsi_k_, updateListGrid_k_);
+            if(psi_j_ && j_ == dir)
+                fillLists( dir, pl, startPt, pmlEdge, nDir, dirMax, *psi_j_, updateListPsi_j_, updateListGrid_j_, updateListFused_j_);
+            else if(psi_k_ && k_ == dir)
+                fillLists( dir, pl, startPt, pmlEdge, nDir, dirMax, *psi_k_, updateListPsi_k_, updateListGrid_k_, updateListFused_k_);
         }
     }
+
+    /**
+     * @brief      The direction the blas operations of an update list move in
+     *
+     * @param[in]  stride  The stride of the operations in grid_i_
+     *
+     * @return     0 for x, 1 for y, or 2 for z
+     */
+    inline int strideDir(int stride)
+    {
+        // Strided operations run along z in 3D and along y in 2D
+        return stride == 1 ? 0 : (grid_i_->local_z() == 1 ? 1 : 2);
+    }
+
+    /**
+     * @brief      Updates $\psi$ and adds it to grid_i in a single pass over each run
+     *
+     * @param      paramList  The fused update list
+     * @param[in]  grid_i     grid_i_
+     * @param      psi        compact storage of the psi field to update
+     * @param[in]  grid       grid used to update psi
+     */
+    static void fusedUpdate(std::vector<updatePsiParams>& paramList, pgrid_ptr grid_i, T* psi, pgrid_ptr grid)
+    {
+        for(auto& param : paramList)
+        {
+            T* ps = psi + param.psiIdx_;
+            T* fi = &grid_i->point(param.loc_[0], param.loc_[1], param.loc_[2]);
+            const T* gm = &grid->point(param.loc_[0]   , param.loc_[1]   , param.loc_[2]   );
+            const T* gp = &grid->point(param.locOff_[0], param.locOff_[1], param.locOff_[2]);
+            const int st = param.stride_;
+            const int pst = param.psiStride_;
+            const coef_type b = param.b_;
+            const coef_type c = param.c_;
+            const coef_type cOff = param.cOff_;
+            const coef_type Db = param.Db_;
+            // Same operation order as the blas update so both give the same $\psi$
+            if(param.Db_ == 0.0)
+            {
+                for(int ii = 0; ii < param.transSz_; ++ii)
+                    ps[ii*pst] = (b * ps[ii*pst] + c * gm[ii*st]) + cOff * gp[ii*st];
+            }
+            else
+            {
+                for(int ii = 0; ii < param.transSz_; ++ii)
+                {
+                    T val = (b * ps[ii*pst] + c * gm[ii*st]) + cOff * gp[ii*st];
+                    ps[ii*pst] = val;
+                    fi[ii*st] += Db * val;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief      Switches the PML to the fused update, which streams through each run once instead of the four strided blas calls
+     */
+    inline void useFusedKernel() {fused_ = true;}
+
     /**
      * @brief updates the girds
      */
     void updateGrid()
     {
-        upPsi_j_(updateListGrid_j_, updateListPsi_j_, grid_i_, psi_j_, grid_k_);
-        upPsi_k_(updateListGrid_k_, updateListPsi_k_, grid_i_, psi_k_, grid_j_);
+        if(fused_)
+        {
+            fusedUpdate(updateListFused_j_, grid_i_, psi_j_ ? psi_j_->data() : nullptr, grid_k_);
+            fusedUpdate(updateListFused_k_, grid_i_, psi_k_ ? psi_k_->data() : nullptr, grid_j_);
+            return;
+        }
+        upPsi_j_(updateListGrid_j_, updateListPsi_j_, grid_i_, psi_j_ ? psi_j_->data() : nullptr, grid_k_);
+        upPsi_k_(updateListGrid_k_, updateListPsi_k_, grid_i_, psi_k_ ? psi_k_->data() : nullptr, grid_j_);
+    }
+
+    /**
+     * @brief      Splits the update lists into the y slabs of the temporally blocked update
+     * @details    Runs along y (only in 2D) are cut at the slab boundaries, all other runs stay in the slab of their row
+     *
+     * @param[in]  slabY  The first row of every slab followed by one past the last row of the last slab
+     */
+    void setupSlabs(const std::vector<int>& slabY)
+    {
+        slabListPsi_j_   = slabRuns(updateListPsi_j_  , slabY);
+        slabListPsi_k_   = slabRuns(updateListPsi_k_  , slabY);
+        slabListGrid_j_  = slabRuns(updateListGrid_j_ , slabY);
+        slabListGrid_k_  = slabRuns(updateListGrid_k_ , slabY);
+        slabListFused_j_ = slabRuns(updateListFused_j_, slabY);
+        slabListFused_k_ = slabRuns(updateListFused_k_, slabY);
+    }
+
+    /**
+     * @brief      Splits an update list into y slabs
+     *
+     * @param[in]  paramList  The update list
+     * @param[in]  slabY      The first row of every slab followed by one past the last row of the last slab
+     *
+     * @return     The runs of paramList inside each slab
+     */
+    template <typename P> std::vector<std::vector<P>> slabRuns(std::vector<P>& paramList, const std::vector<int>& slabY)
+    {
+        std::vector<std::vector<P>> slabLists(slabY.size() - 1);
+        for(auto& param : paramList)
+        {
+            bool alongY = strideDir(param.stride_) == 1;
+            for(int ss = 0; ss < slabLists.size(); ++ss)
+            {
+                int lo = std::max(slabY[ss] - param.loc_[1], 0);
+                int hi = std::min(slabY[ss+1] - param.loc_[1], alongY ? runLength(param) : 1);
+                if(hi <= lo)
+                    continue;
+                P piece = param;
+                if(alongY)
+                {
+                    shiftRun(piece, lo);
+                    runLength(piece) = hi - lo;
+                }
+                slabLists[ss].push_back(piece);
+            }
+        }
+        return slabLists;
+    }
+
+    /**
+     * @return     The number of points in a $\psi$ update run
+     */
+    static inline int& runLength(updatePsiParams& param) {return param.transSz_;}
+
+    /**
+     * @return     The number of points in a grid update run
+     */
+    static inline int& runLength(updateGridParams& param) {return param.nAx_;}
+
+    /**
+     * @brief      Moves the start of a $\psi$ update run along y
+     *
+     * @param      param  The run
+     * @param[in]  nn     The number of points to move by
+     */
+    static inline void shiftRun(updatePsiParams& param, int nn)
+    {
+        param.loc_[1] += nn;
+        param.locOff_[1] += nn;
+        param.psiIdx_ += nn*param.psiStride_;
+    }
+
+    /**
+     * @brief      Moves the start of a grid update run along y
+     *
+     * @param      param  The run
+     * @param[in]  nn     The number of points to move by
+     */
+    static inline void shiftRun(updateGridParams& param, int nn)
+    {
+        param.loc_[1] += nn;
+        param.psiIdx_ += nn*param.psiStride_;
+    }
+
+    /**
+     * @brief      Updates the grids inside one y slab, the same as updateGrid restricted to that slab
+     *
+     * @param[in]  ss    The slab index
+     */
+    void updateSlab(int ss)
+    {
+        if(fused_)
+        {
+            fusedUpdate(slabListFused_j_[ss], grid_i_, psi_j_ ? psi_j_->data() : nullptr, grid_k_);
+            fusedUpdate(slabListFused_k_[ss], grid_i_, psi_k_ ? psi_k_->data() : nullptr, grid_j_);
+            return;
+        }
+        upPsi_j_(slabListGrid_j_[ss], slabListPsi_j_[ss], grid_i_, psi_j_ ? psi_j_->data() : nullptr, grid_k_);
+        upPsi_k_(slabListGrid_k_[ss], slabListPsi_k_[ss], grid_i_, psi_k_ ? psi_k_->data() : nullptr, grid_j_);
+    }
+
+    /**
+     * @brief      Takes over the $\psi$ fields of a PML made from the same inputs with different y process boundaries, must be called by all processes
+     * @details    The compact fields are spread out into temporary grids with the layouts of the old and new field grids, which are moved between processes like the field grids.
+     *
+     * @param      old   The PML being replaced
+     */
+    void migrateFrom(parallelCPML<T>& old)
+    {
+        std::array<std::pair<std::shared_ptr<pmlPsiField<T>>, std::shared_ptr<pmlPsiField<T>>>,2> psis = {{ {psi_j_, old.psi_j_}, {psi_k_, old.psi_k_} }};
+        std::array<std::pair<pgrid_ptr, pgrid_ptr>,2> layouts = {{ {grid_k_, old.grid_k_}, {grid_j_, old.grid_j_} }};
+        for(int pp = 0; pp < 2; ++pp)
+        {
+            if( (psis[pp].first == nullptr) != (psis[pp].second == nullptr) )
+                throw std::logic_error("A PML can only take over the state of a PML made from the same inputs");
+            if(!psis[pp].first)
+                continue;
+            pgrid_ptr layout = layouts[pp].first;
+            pgrid_ptr oldLayout = layouts[pp].second;
+            // The load balancer has already changed the boundaries the weights give, so copy the layouts of the field grids
+            pgrid_ptr oldFull = std::make_shared<parallelGrid<T>>(oldLayout);
+            psis[pp].second->toGrid(*oldFull);
+            pgrid_ptr full = std::make_shared<parallelGrid<T>>(layout);
+            full->migrateFrom(oldFull);
+            psis[pp].first->fromGrid(*full);
+        }
     }
 
     /**
@@ -793,19 +1157,19 @@ namespace pmlUpdateFxnReal
      * @param      gridParamList  list of parameters to update grid_i_
      * @param      psiParamList   ist of parameters to update Psi field
      * @param[in]  grid_i         grid_i_
-     * @param[in]  psi            psi field to update
+     * @param      psi            compact storage of the psi field to update
      * @param[in]  grid           grid used to update psi
      */
-    void addPsi(std::vector<updateGridParams> &gridParamList, std::vector<updatePsiParams> &psiParamList, real_pgrid_ptr grid_i, real_pgrid_ptr psi, real_pgrid_ptr grid);
+    void addPsi(std::vector<updateGridParams> &gridParamList, std::vector<updatePsiParams> &psiParamList, real_pgrid_ptr grid_i, double* psi, real_pgrid_ptr grid);
 
     /**
      * @brief      update psi field
      *
      * @param      list to loop over to update psi
-     * @param[in]  psi field to update
+     * @param      psi compact storage of the psi field to update
      * @param[in]  grid used to update psi
      */
-    void updatePsiField(std::vector<updatePsiParams>&paramList, real_pgrid_ptr psi , real_pgrid_ptr grid);
+    void updatePsiField(std::vector<updatePsiParams>&paramList, double* psi , real_pgrid_ptr grid);
 }
 namespace pmlUpdateFxnCplx
 {
@@ -815,19 +1179,42 @@ namespace pmlUpdateFxnCplx
      * @param      gridParamList  list of parameters to update grid_i_
      * @param      psiParamList   ist of parameters to update Psi field
      * @param[in]  grid_i         grid_i_
-     * @param[in]  psi            psi field to update
+     * @param      psi            compact storage of the psi field to update
+     * @param[in]  grid           grid used to update psi
+     */
+    void addPsi(std::vector<updateGridParams> &gridParamList, std::vector<updatePsiParams> &psiParamList, cplx_pgrid_ptr grid_i, cplx* psi, cplx_pgrid_ptr grid);
+
+    /**
+     * @brief      update psi field
+     *
+     * @param      list to loop over to update psi
+     * @param      psi compact storage of the psi field to update
+     * @param[in]  grid used to update psi
+     */
+    void updatePsiField(std::vector<updatePsiParams>&paramList , cplx* psi , cplx_pgrid_ptr grid);
+}
+
+namespace pmlUpdateFxnFloat
+{
+    /**
+     * @brief      Adds psi to grid_i_
+     *
+     * @param      gridParamList  list of parameters to update grid_i_
+     * @param      psiParamList   ist of parameters to update Psi field
+     * @param[in]  grid_i         grid_i_
+     * @param      psi            compact storage of the psi field to update
      * @param[in]  grid           grid used to update psi
      */
-    void addPsi(std::vector<updateGridParams> &gridParamList, std::vector<updatePsiParams> &psiParamList, cplx_pgrid_ptr grid_i, cplx_pgrid_ptr psi, cplx_pgrid_ptr grid);
+    void addPsi(std::vector<updateGridParams> &gridParamList, std::vector<updatePsiParams> &psiParamList, float_pgrid_ptr grid_i, float* psi, float_pgrid_ptr grid);
 
     /**
      * @brief      update psi field
      *
      * @param      list to loop over to update psi
-     * @param[in]  psi field to update
+     * @param      psi compact storage of the psi field to update
      * @param[in]  grid used to update psi
      */
-    void updatePsiField(std::vector<updatePsiParams>&paramList , cplx_pgrid_ptr psi , cplx_pgrid_ptr grid);
+    void updatePsiField(std::vector<updatePsiParams>&paramList, float* psi , float_pgrid_ptr grid);
 }
 
 class parallelCPMLReal : public parallelCPML<double>
@@ -837,7 +1224,7 @@ public:
      * @brief      Constructor class
      *
      * @param[in]  gridComm  mpi communicator
-     * @param[in]  weights   The weights
+     * @param[in]  weights   The summed weight of every plane normal to each direction
      * @param[in]  grid_i    shared pointer to grid_i (field PML is being applied to)
      * @param[in]  grid_j    shared pointer to grid_j (field polarized in the j direction of the PML; nullptr if none)
      * @param[in]  grid_k    shared pointer to grid_k (field polarized in the k direction of the PML; nullptr if none)
@@ -852,7 +1239,7 @@ public:
      * @param[in]  phys_Ey   The physical ey grid
      * @param[in]  objArr    The object arr
      */
-    parallelCPMLReal(std::shared_ptr<mpiInterface> gridComm, std::vector<real_grid_ptr> weights, real_pgrid_ptr grid_i, real_pgrid_ptr grid_j, real_pgrid_ptr grid_k, POLARIZATION pol_i, std::array<int,3> n_vec, double m, double ma, double aMax, std::array<double,3> d, double dt, int_pgrid_ptr physGrid, std::vector<std::shared_ptr<Obj>> objArr);
+    parallelCPMLReal(std::shared_ptr<mpiInterface> gridComm, const planeWeightSums& weights, real_pgrid_ptr grid_i, real_pgrid_ptr grid_j, real_pgrid_ptr grid_k, POLARIZATION pol_i, std::array<int,3> n_vec, double m, double ma, double aMax, std::array<double,3> d, double dt, int_pgrid_ptr physGrid, std::vector<std::shared_ptr<Obj>> objArr);
 };
 
 class parallelCPMLCplx : public parallelCPML<cplx>
@@ -862,7 +1249,32 @@ public:
      * @brief      Constructor class
      *
      * @param[in]  gridComm  mpi communicator
-     * @param[in]  weights   The weights
+     * @param[in]  weights   The summed weight of every plane normal to each direction
+     * @param[in]  grid_i    shared pointer to grid_i (field PML is being applied to)
+     * @param[in]  grid_j    shared pointer to grid_j (field polarized in the j direction of the PML; nullptr if none)
+     * @param[in]  grid_k    shared pointer to grid_k (field polarized in the k direction of the PML; nullptr if none)
+     * @param[in]  pol_i     polarization of grid_o
+     * @param[in]  n_vec     Vector storing thickness of the PMLs in all directions
+     * @param[in]  m         scalling factor for sigma
+     * @param[in]  ma        scaling factor for a
+     * @param[in]  aMax      max a value
+     * @param[in]  d         vector storing the step sizes in all directions
+     * @param[in]  dt        time step
+     * @param[in]  phys_Ex   The physical ex grid
+     * @param[in]  phys_Ey   The physical ey grid
+     * @param[in]  objArr    The object arr
+     */
+    parallelCPMLCplx(std::shared_ptr<mpiInterface> gridComm, const planeWeightSums& weights, std::shared_ptr<parallelGrid<cplx > > grid_i, std::shared_ptr<parallelGrid<cplx > > grid_j, std::shared_ptr<parallelGrid<cplx > > grid_k, POLARIZATION pol_i, std::array<int,3> n_vec, double m, double ma, double aMax, std::array<double,3> d, double dt, int_pgrid_ptr physGrid, std::vector<std::shared_ptr<Obj>> objArr);
+};
+
+class parallelCPMLFloat : public parallelCPML<float>
+{
+public:
+    /**
+     * @brief      Constructor class
+     *
+     * @param[in]  gridComm  mpi communicator
+     * @param[in]  weights   The summed weight of every plane normal to each direction
      * @param[in]  grid_i    shared pointer to grid_i (field PML is being applied to)
      * @param[in]  grid_j    shared pointer to grid_j (field polarized in the j direction of the PML; nullptr if none)
      * @param[in]  grid_k    shared pointer to grid_k (field polarized in the k direction of the PML; nullptr if none)
@@ -877,6 +1289,6 @@ public:
      * @param[in]  phys_Ey   The physical ey grid
      * @param[in]  objArr    The object arr
      */
-    parallelCPMLCplx(std::shared_ptr<mpiInterface> gridComm, std::vector<real_grid_ptr> weights, std::shared_ptr<parallelGrid<cplx > > grid_i, std::shared_ptr<parallelGrid<cplx > > grid_j, std::shared_ptr<parallelGrid<cplx > > grid_k, POLARIZATION pol_i, std::array<int,3> n_vec, double m, double ma, double aMax, std::array<double,3> d, double dt, int_pgrid_ptr physGrid, std::vector<std::shared_ptr<Obj>> objArr);
+    parallelCPMLFloat(std::shared_ptr<mpiInterface> gridComm, const planeWeightSums& weights, float_pgrid_ptr grid_i, float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, POLARIZATION pol_i, std::array<int,3> n_vec, double m, double ma, double aMax, std::array<double,3> d, double dt, int_pgrid_ptr physGrid, std::vector<std::shared_ptr<Obj>> objArr);
 };
 #endif
\ No newline at end of file
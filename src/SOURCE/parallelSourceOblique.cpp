@@ -24,3 +24,16 @@ void parallelSourceObliqueCplx::addPul(double t)
             *param.loc_ += param.scalefact_ * pul->pulse(t - param.t_off_);
     grid_->transferDat();
 }
+
+parallelSourceObliqueFloat::parallelSourceObliqueFloat(std::shared_ptr<mpiInterface> gridComm, std::vector<std::shared_ptr<PulseBase>> pulse, float_pgrid_ptr grid, POLARIZATION pol, double dt, std::array<int,3> loc, std::array<int,3> sz, double phi, double theta) :
+    parallelSourceObliqueBase<float>(gridComm, pulse, grid, pol, dt, loc, sz, phi, theta)
+{}
+
+void parallelSourceObliqueFloat::addPul(double t)
+{
+    for(auto& pul : pulse_)
+        for(auto& param : updateSrcParams_)
+            *param.loc_ += param.scalefact_ * std::real(pul->pulse(t - param.t_off_) );
+    grid_->transferDat();
+
+}
@@ -206,4 +206,27 @@ public:
     void addPul(double t);
 };
 
+class parallelSourceObliqueFloat : public parallelSourceObliqueBase<float>
+{
+public:
+    /**
+     * @brief Constructor for the parallel source
+     *
+     * @param[in]  gridComm       mpiInterface for the caclutlation
+     * @param[in]  srcNum     index of the source in srcArr_
+     * @param[in]  pulse      pulse of the calculation
+     * @param[in]  grid       grid the source adds the pulse to
+     * @param[in]  dt         time step of the calculation
+     * @param[in]  loc        location of the lower left corner of source
+     * @param[in]  sz         size of the soft source
+     */
+    parallelSourceObliqueFloat(std::shared_ptr<mpiInterface> gridComm,  std::vector<std::shared_ptr<PulseBase>> pulse, float_pgrid_ptr grid, POLARIZATION pol, double dt, std::array<int,3> loc, std::array<int,3> sz, double phi, double theta);
+    /**
+     * @brief      adds the pulse to the grid
+     *
+     * @param[in]  t     current time
+     */
+    void addPul(double t);
+};
+
 #endif
\ No newline at end of file
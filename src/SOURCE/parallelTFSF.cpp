@@ -45,6 +45,42 @@ void tfsfUpdateFxnReal::transferDat(real_pgrid_ptr grid)
     grid->transferDat();
 }
 
+void tfsfUpdateFxnFloat::addTFSFTwoComp(float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur)
+{
+    tfsfUpdateFxnFloat::addTFSFOneCompJ(grid_j, grid_k, incd, incdTransfer, sur);
+    tfsfUpdateFxnFloat::addTFSFOneCompK(grid_j, grid_k, incd, incdTransfer, sur);
+}
+
+void tfsfUpdateFxnFloat::addTFSFOneCompJ(float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur)
+{
+    for(int ll = 0; ll < sur->szTrans_j_[1]; ++ll)
+    {
+        zcopy_(sur->szTrans_j_[0], &incd->point(sur->incdStart_j_+ll*sur->addIncdProp_,0), sur->strideIncd_, incdTransfer, 1);
+        zscal_(sur->szTrans_j_[0], sur->prefactor_j_, incdTransfer, 1);
+        // The incident fields stay in double precision, only the real part is rounded when it is added to the grid
+        float* field = &grid_j->point(sur->loc_[0]+ll*sur->addVec_[0], sur->loc_[1]+ll*sur->addVec_[1], sur->loc_[2]+ll*sur->addVec_[2]);
+        for(int ii = 0; ii < sur->szTrans_j_[0]; ++ii)
+            field[ii*sur->strideField_] += static_cast<float>( std::real(incdTransfer[ii]) );
+    }
+}
+
+void tfsfUpdateFxnFloat::addTFSFOneCompK(float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur)
+{
+    for(int ll = 0; ll < sur->szTrans_k_[1]; ++ll)
+    {
+        zcopy_(sur->szTrans_k_[0], &incd->point(sur->incdStart_k_+ll*sur->addIncdProp_,0), sur->strideIncd_, incdTransfer, 1);
+        zscal_(sur->szTrans_k_[0], sur->prefactor_k_, incdTransfer, 1);
+        float* field = &grid_k->point(sur->loc_[0]+ll*sur->addVec_[0], sur->loc_[1]+ll*sur->addVec_[1], sur->loc_[2]+ll*sur->addVec_[2]);
+        for(int ii = 0; ii < sur->szTrans_k_[0]; ++ii)
+            field[ii*sur->strideField_] += static_cast<float>( std::real(incdTransfer[ii]) );
+    }
+}
+
+void tfsfUpdateFxnFloat::transferDat(float_pgrid_ptr grid)
+{
+    grid->transferDat();
+}
+
 void tfsfUpdateFxnCplx::addTFSFTwoComp(cplx_pgrid_ptr grid_j, cplx_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur)
 {
     for(int ll = 0; ll < sur->szTrans_j_[1]; ++ll)
@@ -293,6 +329,229 @@ parallelTFSFReal::parallelTFSFReal(std::shared_ptr<mpiInterface> gridComm, std::
         addHFront_ = [](real_pgrid_ptr grid_j, real_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
     }
 }
+parallelTFSFFloat::parallelTFSFFloat(std::shared_ptr<mpiInterface> gridComm, std::array<int,3> loc, std::array<int,3> sz, double theta, double phi, double psi, POLARIZATION circPol, double kLenRelJ, double dx, double dt, std::vector<std::shared_ptr<PulseBase>> pul, float_pgrid_ptr Ex, float_pgrid_ptr Ey, float_pgrid_ptr Ez, float_pgrid_ptr Hx, float_pgrid_ptr Hy, float_pgrid_ptr Hz) :
+    parallelTFSFBase<float>(gridComm, loc, sz, theta, phi, psi, circPol, kLenRelJ, dx, dt, pul, Ex, Ey, Ez, Hx, Hy,  Hz)
+{
+    if(Ez_ && Hz_)
+    {
+        if(botSurE_)
+            addEBot_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addEBot_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        if(botSurH_)
+            addHBot_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addHBot_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(topSurE_)
+            addETop_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addETop_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(topSurH_)
+            addHTop_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addHTop_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(leftSurE_)
+            addELeft_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addELeft_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(leftSurH_)
+            addHLeft_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addHLeft_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(rightSurE_)
+            addERight_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addERight_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(rightSurH_)
+            addHRight_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addHRight_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(backSurE_)
+            addEBack_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addEBack_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(backSurH_)
+            addHBack_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addHBack_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(frontSurE_)
+            addEFront_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addEFront_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+
+        if(frontSurH_)
+            addHFront_ = tfsfUpdateFxnFloat::addTFSFTwoComp;
+        else
+            addHFront_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+    }
+    else if(Hz)
+    {
+        if(botSurH_)
+        {
+            addHBot_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addHBot_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(botSurE_)
+        {
+            addEBot_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addEBot_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(topSurH_)
+        {
+            addHTop_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addHTop_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(topSurE_)
+        {
+            addETop_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addETop_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(leftSurH_)
+        {
+            addHLeft_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addHLeft_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(leftSurE_)
+        {
+            addELeft_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addELeft_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(rightSurH_)
+        {
+            addHRight_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addHRight_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(rightSurE_)
+        {
+            addERight_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addERight_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        addEBack_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        addHBack_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        addEFront_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        addHFront_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+    }
+    else if(Ez)
+    {
+        if(botSurH_)
+        {
+            addHBot_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addHBot_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(botSurE_)
+        {
+            addEBot_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addEBot_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(topSurH_)
+        {
+            addHTop_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addHTop_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(topSurE_)
+        {
+            addETop_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addETop_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(leftSurH_)
+        {
+            addHLeft_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addHLeft_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(leftSurE_)
+        {
+            addELeft_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addELeft_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(rightSurH_)
+        {
+            addHRight_ = tfsfUpdateFxnFloat::addTFSFOneCompJ;
+        }
+        else
+        {
+            addHRight_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        if(rightSurE_)
+        {
+            addERight_ = tfsfUpdateFxnFloat::addTFSFOneCompK;
+        }
+        else
+        {
+            addERight_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        }
+
+        addEBack_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        addHBack_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        addEFront_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+        addHFront_ = [](float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur){return;};
+    }
+}
 parallelTFSFCplx::parallelTFSFCplx(std::shared_ptr<mpiInterface> gridComm, std::array<int,3> loc, std::array<int,3> sz, double theta, double phi, double psi, POLARIZATION circPol, double kLenRelJ, double dx, double dt, std::vector<std::shared_ptr<PulseBase>> pul, cplx_pgrid_ptr Ex, cplx_pgrid_ptr Ey, cplx_pgrid_ptr Ez, cplx_pgrid_ptr Hx, cplx_pgrid_ptr Hy, cplx_pgrid_ptr Hz) :
     parallelTFSFBase<cplx>(gridComm, loc, sz, theta, phi, psi, circPol, kLenRelJ, dx, dt, pul, Ex, Ey, Ez, Hx, Hy, Hz)
 {
@@ -3,6 +3,10 @@
 
 #include <SOURCE/Pulse.hpp>
 #include <unordered_map>
+#include <fstream>
+#include <sstream>
+#include <functional>
+#include <cstdio>
 
 struct paramStoreTFSF
 {
@@ -62,6 +66,17 @@ protected:
     std::vector<cplx> incdTransfer_; //!< scartch space to transfer a cplx pulse with cplx prefactor to a real grid
     int originQuadrent_; //!< which quadrant the origin is in 1 is bot left increases in a counter clockwise direction
 
+    int tableRows_; //!< number of time steps stored in the incident field table (0 if the 1D grid is stepped every time step)
+    std::vector<int> tableIdxE_; //!< indexes of E_incd_ read by this process (the H surfaces and the accessor functions)
+    std::vector<int> tableIdxH_; //!< indexes of H_incd_ read by this process (the E surfaces and the accessor functions)
+    std::vector<cplx> tableE_; //!< values of E_incd_ at tableIdxE_ after every step in the table
+    std::vector<cplx> tableH_; //!< values of H_incd_ at tableIdxH_ after every step in the table
+    std::vector<cplx> tableTail_; //!< the full E, H, D, and B incident fields after the last step in the table, the 1D grid continues from them if the run is longer than the table
+
+    std::vector<std::array<std::shared_ptr<paramStoreTFSF>,12>> slabSur_; //!< the parts of the H surfaces (bot, top, left, right, back, front) then the E surfaces inside each y slab of the temporally blocked update
+    std::vector<std::shared_ptr<Grid<cplx>>> tileE_incd_; //!< E_incd_ before each step of the current temporally blocked update
+    std::vector<std::shared_ptr<Grid<cplx>>> tileH_incd_; //!< H_incd_ after each step of the current temporally blocked update
+
     std::shared_ptr<paramStoreTFSF> botSurE_; //!< parameter structure describing parameters needed to add the TFSF incident E field to the bot surface of the TFSF region
     std::shared_ptr<paramStoreTFSF> botSurH_; //!< parameter structure describing parameters needed to add the TFSF incident H field to the bot surface of the TFSF region
 
@@ -145,7 +160,8 @@ public:
         Hx_(Hx),
         Hy_(Hy),
         Hz_(Hz),
-        incdTransfer_( sz[isamax_(sz.size(), sz.data(), 1)-1] )
+        incdTransfer_( sz[isamax_(sz.size(), sz.data(), 1)-1] ),
+        tableRows_(0)
     {
         if(std::any_of(sz_.begin(), sz_.end(), [](int a){return a == 1; }))
             gridLen_ = 2.0 * std::accumulate(sz_.begin(), sz_.end(), 0);
@@ -590,6 +606,93 @@ public:
         addEBack_ (Ex_, Ey_, H_incd_, incdTransfer_.data(), backSurE_);
         addEFront_(Ex_, Ey_, H_incd_, incdTransfer_.data(), frontSurE_);
     }
+    /**
+     * @brief      Cuts the surfaces into the y slabs of the temporally blocked update
+     *
+     * @param[in]  slabY  The first row of every slab followed by one past the last row of the last slab
+     */
+    void setupSlabs(const std::vector<int>& slabY)
+    {
+        std::array<std::shared_ptr<paramStoreTFSF>,12> surs = {{ botSurH_, topSurH_, leftSurH_, rightSurH_, backSurH_, frontSurH_, botSurE_, topSurE_, leftSurE_, rightSurE_, backSurE_, frontSurE_ }};
+        std::shared_ptr<parallelGrid<T>> grid = Ex_ ? Ex_ : Hx_;
+        int yStride = grid->local_x() * grid->local_z();
+        slabSur_.resize(slabY.size() - 1);
+        for(int ss = 0; ss < slabSur_.size(); ++ss)
+        {
+            for(int ii = 0; ii < surs.size(); ++ii)
+            {
+                slabSur_[ss][ii] = nullptr;
+                if(!surs[ii])
+                    continue;
+                std::shared_ptr<paramStoreTFSF> sur = std::make_shared<paramStoreTFSF>(*surs[ii]);
+                int lo = std::max(slabY[ss] - sur->loc_[1], 0);
+                if(sur->strideField_ == yStride)
+                {
+                    // Points of each line run along y, with a negative stride the incident field is read from the end of the line
+                    for(auto sz : {std::make_pair(&sur->szTrans_j_[0], &sur->incdStart_j_), std::make_pair(&sur->szTrans_k_[0], &sur->incdStart_k_)})
+                    {
+                        int hi = std::min(slabY[ss+1] - sur->loc_[1], *sz.first);
+                        *sz.second += (sur->strideIncd_ >= 0) ? lo*sur->strideIncd_ : (*sz.first - std::max(hi, lo) )*std::abs(sur->strideIncd_);
+                        *sz.first = std::max(hi - lo, 0);
+                    }
+                    sur->loc_[1] += lo;
+                }
+                else if(sur->addVec_[1] != 0)
+                {
+                    // The lines are stacked along y
+                    for(auto sz : {std::make_pair(&sur->szTrans_j_[1], &sur->incdStart_j_), std::make_pair(&sur->szTrans_k_[1], &sur->incdStart_k_)})
+                    {
+                        *sz.first = std::max(std::min(slabY[ss+1] - sur->loc_[1], *sz.first) - lo, 0);
+                        *sz.second += lo*sur->addIncdProp_;
+                    }
+                    sur->loc_[1] += lo;
+                }
+                else if(sur->loc_[1] < slabY[ss] || sur->loc_[1] >= slabY[ss+1])
+                {
+                    continue;
+                }
+                if(sur->szTrans_j_[0] * sur->szTrans_j_[1] > 0 || sur->szTrans_k_[0] * sur->szTrans_k_[1] > 0)
+                    slabSur_[ss][ii] = sur;
+            }
+        }
+    }
+
+    /**
+     * @brief      Steps the incident fields for one step of a temporally blocked update and keeps the values the surfaces of that step use
+     *
+     * @param[in]  tau   The index of the step inside the blocked update
+     */
+    void stepTileLevel(int tau)
+    {
+        if(tileE_incd_.size() <= tau)
+        {
+            tileE_incd_.push_back(std::make_shared<Grid<cplx>>(*E_incd_) );
+            tileH_incd_.push_back(std::make_shared<Grid<cplx>>(*H_incd_) );
+        }
+        std::copy_n(E_incd_->data(), E_incd_->size(), tileE_incd_[tau]->data() );
+        step();
+        std::copy_n(H_incd_->data(), H_incd_->size(), tileH_incd_[tau]->data() );
+    }
+
+    /**
+     * @brief      Adds the incident fields to the parts of the surfaces inside one y slab, the same as updateFileds restricted to that slab
+     *
+     * @param[in]  ss    The slab index
+     * @param[in]  tau   The index of the step inside the blocked update (stepTileLevel must have been called for it)
+     * @param[in]  E     If true add to the E fields otherwise to the H fields
+     */
+    void addSlab(int ss, int tau, bool E)
+    {
+        std::array<decltype(addHBot_)*,12> fxns = {{ &addHBot_, &addHTop_, &addHLeft_, &addHRight_, &addHBack_, &addHFront_, &addEBot_, &addETop_, &addELeft_, &addERight_, &addEBack_, &addEFront_ }};
+        // Same field grids as updateFileds
+        std::array<std::shared_ptr<parallelGrid<T>>,12> gridJ = {{ Hz_, Hz_, Hy_, Hy_, Hx_, Hx_, Ez_, Ez_, Ey_, Ey_, Ex_, Ex_ }};
+        std::array<std::shared_ptr<parallelGrid<T>>,12> gridK = {{ Hx_, Hx_, Hz_, Hz_, Hy_, Hy_, Ex_, Ex_, Ez_, Ez_, Ey_, Ey_ }};
+        std::shared_ptr<Grid<cplx>> incd = E ? tileH_incd_[tau] : tileE_incd_[tau];
+        for(int ii = E ? 6 : 0; ii < (E ? 12 : 6); ++ii)
+            if(slabSur_[ss][ii])
+                (*fxns[ii])(gridJ[ii], gridK[ii], incd, incdTransfer_.data(), slabSur_[ss][ii]);
+    }
+
     /**
      * @return origin Location
      */
@@ -659,10 +762,28 @@ public:
 
     /**
      * @brief Moves the incident fields forward one time step
-     * @details Uses the 1D FDTD equations to propagate the fields in time
+     * @details Uses the 1D FDTD equations to propagate the fields in time, or copies the fields from the incident field table if it has been precomputed
      */
     void step()
     {
+        // Inside the table only the points read by this process are set
+        int row = static_cast<int>(t_step_);
+        if(row < tableRows_)
+        {
+            loadTableRow(row);
+            t_step_++;
+            return;
+        }
+        // Past the table continue from the full 1D fields at its end
+        if(tableRows_ > 0 && row == tableRows_)
+        {
+            int off = 0;
+            for(auto& grid : {E_incd_, H_incd_, D_incd_, B_incd_})
+            {
+                std::copy_n(tableTail_.data() + off, grid->size(), grid->data() );
+                off += grid->size();
+            }
+        }
         // Update incident H field
         zaxpy_(gridLen_+4,      dt_/dx_, &E_incd_->point(0,0), 1, &H_incd_->point(0,0), 1);
         zaxpy_(gridLen_+4, -1.0*dt_/dx_, &E_incd_->point(1,0), 1, &H_incd_->point(0,0), 1);
@@ -693,6 +814,207 @@ public:
         zaxpy_(20, -1.0, D_old_.data()       , 1, &E_incd_->point(gridLen_+4,0), 1);
         t_step_++;
     }
+
+    /**
+     * @brief      Copies the incident fields and time step from a TFSF surface with the same parameters (used when the propagator is rebuilt by a load rebalance)
+     *
+     * @param      old   The TFSF surface being replaced
+     */
+    void copyIncdState(parallelTFSFBase<T>& old)
+    {
+        t_step_ = old.t_step_;
+        zcopy_(E_incd_->size(), old.E_incd_->data(), 1, E_incd_->data(), 1);
+        zcopy_(H_incd_->size(), old.H_incd_->data(), 1, H_incd_->data(), 1);
+        zcopy_(D_incd_->size(), old.D_incd_->data(), 1, D_incd_->data(), 1);
+        zcopy_(B_incd_->size(), old.B_incd_->data(), 1, B_incd_->data(), 1);
+        // The old process only stored the points its surfaces read, so refill the ones this process reads
+        int row = static_cast<int>(t_step_);
+        if(row > 0 && row <= tableRows_)
+            loadTableRow(row - 1);
+    }
+
+    /**
+     * @brief      Precomputes the incident fields read by this process for the first nSteps time steps so step() becomes a table look up
+     * @details    Only the pulse, dx_, dt_, and gridLen_ enter the 1D grid (the angles only change the prefactors of the surfaces), so the table is keyed by the summed pulse values at every time step and those three values. If cacheFile is not empty the table is read from cacheFile_<key>.bin if it exists and matches; otherwise it is calculated and the first process writes the full 1D fields at every step to that file for later runs. Must be called before the first time step.
+     *
+     * @param[in]  nSteps     The number of time steps in the table, the 1D grid is stepped as before after them
+     * @param[in]  cacheFile  The prefix of the cache file (empty to always calculate the table)
+     */
+    void precomputeTable(int nSteps, const std::string& cacheFile)
+    {
+        if(t_step_ != 0)
+            throw std::logic_error("The TFSF incident field table has to be set up before the first time step");
+        tableIdxE_ = incdIndexes({{ botSurH_, topSurH_, leftSurH_, rightSurH_, backSurH_, frontSurH_ }});
+        tableIdxH_ = incdIndexes({{ botSurE_, topSurE_, leftSurE_, rightSurE_, backSurE_, frontSurE_ }});
+        tableE_.assign(static_cast<size_t>(nSteps) * tableIdxE_.size(), 0.0);
+        tableH_.assign(static_cast<size_t>(nSteps) * tableIdxH_.size(), 0.0);
+        tableTail_.assign(E_incd_->size() + H_incd_->size() + D_incd_->size() + B_incd_->size(), 0.0);
+
+        std::vector<cplx> pulVals(nSteps, 0.0);
+        for(int tt = 0; tt < nSteps; ++tt)
+            for(auto& pul : pul_)
+                pulVals[tt] += pul->pulse(static_cast<double>(tt)*dt_);
+        std::string fname = cacheFile.size() > 0 ? tableCacheName(cacheFile, pulVals) : "";
+
+        if(fname.size() == 0 || !readTable(fname, pulVals) )
+        {
+            // Only the first process saves the table, written to a temporary file first so no other run reads a partial one
+            std::ofstream out;
+            std::string tmpName = fname + ".tmp" + std::to_string(mpi::communicator().rank() );
+            if(gridComm_->rank() == 0 && fname.size() > 0)
+            {
+                out.open(tmpName, std::ios::out | std::ios::binary);
+                writeTableHeader(out, pulVals);
+            }
+            for(int tt = 0; tt < nSteps; ++tt)
+            {
+                step();
+                for(int ii = 0; ii < tableIdxE_.size(); ++ii)
+                    tableE_[tt*tableIdxE_.size() + ii] = E_incd_->point(tableIdxE_[ii], 0);
+                for(int ii = 0; ii < tableIdxH_.size(); ++ii)
+                    tableH_[tt*tableIdxH_.size() + ii] = H_incd_->point(tableIdxH_[ii], 0);
+                if(out.is_open() )
+                {
+                    out.write(reinterpret_cast<char*>(E_incd_->data() ), E_incd_->size()*sizeof(cplx) );
+                    out.write(reinterpret_cast<char*>(H_incd_->data() ), H_incd_->size()*sizeof(cplx) );
+                }
+            }
+            int off = 0;
+            for(auto& grid : {E_incd_, H_incd_, D_incd_, B_incd_})
+            {
+                std::copy_n(grid->data(), grid->size(), tableTail_.data() + off);
+                off += grid->size();
+                std::fill_n(grid->data(), grid->size(), cplx(0.0) );
+            }
+            t_step_ = 0;
+            if(out.is_open() )
+            {
+                out.write(reinterpret_cast<char*>(tableTail_.data() + E_incd_->size() + H_incd_->size() ), (D_incd_->size() + B_incd_->size() )*sizeof(cplx) );
+                out.close();
+                if(!out || std::rename(tmpName.c_str(), fname.c_str() ) != 0)
+                    std::remove(tmpName.c_str() );
+            }
+        }
+        tableRows_ = nSteps;
+    }
+
+    /**
+     * @return     The number of time steps stored in the incident field table
+     */
+    inline int tableRows() {return tableRows_;}
+
+protected:
+    /**
+     * @brief      Finds the points of the 1D grid the add functions of a set of surfaces read
+     *
+     * @param[in]  surs  The surfaces (null surfaces are skipped)
+     *
+     * @return     The sorted indexes read by the surfaces and the accessor functions
+     */
+    std::vector<int> incdIndexes(const std::array<std::shared_ptr<paramStoreTFSF>,6>& surs)
+    {
+        // The accessor functions read points 1 to 3 of both fields
+        std::vector<int> idx = {1, 2, 3};
+        for(auto& sur : surs)
+        {
+            if(!sur)
+                continue;
+            for(auto& part : { std::make_pair(sur->incdStart_j_, sur->szTrans_j_), std::make_pair(sur->incdStart_k_, sur->szTrans_k_) })
+            {
+                // A negative stride reads the same points backwards
+                for(int ll = 0; ll < part.second[1]; ++ll)
+                    for(int ii = 0; ii < part.second[0]; ++ii)
+                        idx.push_back(part.first + ll*sur->addIncdProp_ + ii*std::abs(sur->strideIncd_) );
+            }
+        }
+        std::sort(idx.begin(), idx.end() );
+        idx.erase(std::unique(idx.begin(), idx.end() ), idx.end() );
+        return idx;
+    }
+
+    /**
+     * @brief      Copies the incident fields after a step in the table into the points of the 1D grid this process reads
+     *
+     * @param[in]  row   The row of the table
+     */
+    void loadTableRow(int row)
+    {
+        const cplx* rowE = tableE_.data() + static_cast<size_t>(row) * tableIdxE_.size();
+        const cplx* rowH = tableH_.data() + static_cast<size_t>(row) * tableIdxH_.size();
+        for(int ii = 0; ii < tableIdxE_.size(); ++ii)
+            E_incd_->point(tableIdxE_[ii], 0) = rowE[ii];
+        for(int ii = 0; ii < tableIdxH_.size(); ++ii)
+            H_incd_->point(tableIdxH_[ii], 0) = rowH[ii];
+    }
+
+    /**
+     * @brief      Makes the name of the cache file from its prefix and a hash of the table parameters
+     *
+     * @param[in]  prefix   The prefix of the cache file
+     * @param[in]  pulVals  The summed pulse values at every time step
+     *
+     * @return     prefix_<hash>.bin
+     */
+    std::string tableCacheName(const std::string& prefix, const std::vector<cplx>& pulVals)
+    {
+        std::ostringstream key;
+        writeTableHeader(key, pulVals);
+        std::ostringstream fname;
+        fname << prefix << "_" << std::hex << std::hash<std::string>()(key.str() ) << ".bin";
+        return fname.str();
+    }
+
+    /**
+     * @brief      Writes the parameters the table depends on (the start of the cache file)
+     *
+     * @param      out      The output stream
+     * @param[in]  pulVals  The summed pulse values at every time step
+     */
+    void writeTableHeader(std::ostream& out, const std::vector<cplx>& pulVals)
+    {
+        int nSteps = pulVals.size();
+        out.write(reinterpret_cast<const char*>(&gridLen_), sizeof(int) );
+        out.write(reinterpret_cast<const char*>(&nSteps), sizeof(int) );
+        out.write(reinterpret_cast<const char*>(&dx_), sizeof(double) );
+        out.write(reinterpret_cast<const char*>(&dt_), sizeof(double) );
+        out.write(reinterpret_cast<const char*>(pulVals.data() ), nSteps*sizeof(cplx) );
+    }
+
+    /**
+     * @brief      Reads the table from a cache file
+     *
+     * @param[in]  fname    The cache file
+     * @param[in]  pulVals  The summed pulse values at every time step
+     *
+     * @return     True if the file exists, was made with the same parameters, and is complete
+     */
+    bool readTable(const std::string& fname, const std::vector<cplx>& pulVals)
+    {
+        std::ifstream in(fname, std::ios::in | std::ios::binary);
+        if(!in)
+            return false;
+        std::ostringstream key;
+        writeTableHeader(key, pulVals);
+        std::string header(key.str().size(), '\0');
+        in.read(&header[0], header.size() );
+        if(!in || header != key.str() )
+            return false;
+
+        std::vector<cplx> row(E_incd_->size() + H_incd_->size() );
+        for(int tt = 0; tt < pulVals.size(); ++tt)
+        {
+            in.read(reinterpret_cast<char*>(row.data() ), row.size()*sizeof(cplx) );
+            for(int ii = 0; ii < tableIdxE_.size(); ++ii)
+                tableE_[tt*tableIdxE_.size() + ii] = row[tableIdxE_[ii]];
+            for(int ii = 0; ii < tableIdxH_.size(); ++ii)
+                tableH_[tt*tableIdxH_.size() + ii] = row[E_incd_->size() + tableIdxH_[ii]];
+        }
+        // The last row holds the E and H parts of the tail
+        std::copy(row.begin(), row.end(), tableTail_.begin() );
+        in.read(reinterpret_cast<char*>(tableTail_.data() + row.size() ), (D_incd_->size() + B_incd_->size() )*sizeof(cplx) );
+        return static_cast<bool>(in);
+    }
+public:
 };
 
 namespace tfsfUpdateFxnReal
@@ -777,6 +1099,48 @@ namespace tfsfUpdateFxnCplx
     void transferDat(cplx_pgrid_ptr);
 }
 
+namespace tfsfUpdateFxnFloat
+{
+    /**
+     * @brief      Adds a tfsf fields to two components of the single precision grids.
+     *
+     * @param[in]  grid_j        grid pointers to the grid j
+     * @param[in]  grid_k        grid pointers to the grid k
+     * @param[in]  incd          The incd field value
+     * @param[in]  incdTransfer  pointer to the start of scratch space vector fro transfer
+     * @param[in]  sur           The surface parameter struct
+     */
+    void addTFSFTwoComp (float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur);
+
+    /**
+     * @brief      Adds a tfsf fields to the j component of the single precision grids.
+     *
+     * @param[in]  grid_j        grid pointers to the grid j
+     * @param[in]  grid_k        grid pointers to the grid k
+     * @param[in]  incd          The incd field value
+     * @param[in]  incdTransfer  pointer to the start of scratch space vector fro transfer
+     * @param[in]  sur           The surface parameter struct
+     */
+    void addTFSFOneCompJ(float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur);
+
+    /**
+     * @brief      Adds a tfsf fields to k component of the single precision grids.
+     *
+     * @param[in]  grid_j        grid pointers to the grid j
+     * @param[in]  grid_k        grid pointers to the grid k
+     * @param[in]  incd          The incd field value
+     * @param[in]  incdTransfer  pointer to the start of scratch space vector fro transfer
+     * @param[in]  sur           The surface parameter struct
+     */
+    void addTFSFOneCompK(float_pgrid_ptr grid_j, float_pgrid_ptr grid_k, cplx_grid_ptr incd, cplx* incdTransfer, std::shared_ptr<paramStoreTFSF> sur);
+    /**
+     * @brief      does grid->gridTransfer() for grid pointers
+     *
+     * @param[in]  grid grid that needs grid->gridTransfer to it
+     */
+    void transferDat(float_pgrid_ptr grid);
+}
+
 class parallelTFSFReal : public parallelTFSFBase<double>
 {
 public:
@@ -831,5 +1195,32 @@ public:
      */
     parallelTFSFCplx(std::shared_ptr<mpiInterface> gridComm, std::array<int,3> locO, std::array<int,3> sz, double theta, double phi, double psi, POLARIZATION circPl, double kLenRelJ, double dx, double dt,  std::vector<std::shared_ptr<PulseBase>> pul, cplx_pgrid_ptr Ex, cplx_pgrid_ptr Ey, cplx_pgrid_ptr Ez, cplx_pgrid_ptr Hx, cplx_pgrid_ptr Hy, cplx_pgrid_ptr Hz);
 };
+class parallelTFSFFloat : public parallelTFSFBase<float>
+{
+public:
+
+    /**
+     * @brief      Construct a TFSF surface
+     *
+     * @param[in]  gridComm  The mpiInterface of the grids
+     * @param[in]  locO      location of TFSF origin
+     * @param[in]  sz        size of the total field region
+     * @param[in]  theta     polar angle of the plane wave's k-vector
+     * @param[in]  phi       angle of plane wave's k-vector in the xy plane
+     * @param[in]  psi       angle describing the polarization of the plane wave from the vector \vec{k}\times e_{z} (if k is along z psi_ = phi_)
+     * @param[in]  circPol   POLARIZATION::R if R polarized, L if L polarized, linear if anything else
+     * @param[in]  kLenRelJ  ratio between the size of the axis oriented along psi to that perpendicular to it for elliptically polarized light
+     * @param[in]  dx        step size of incident fields
+     * @param[in]  dt        time step
+     * @param[in]  pul       incident pulseBase
+     * @param[in]  Ex        grid_ptr to the Ex field
+     * @param[in]  Ey        grid_ptr to the Ey field
+     * @param[in]  Ez        grid_ptr to the Ez field
+     * @param[in]  Hx        grid_ptr to the Hx field
+     * @param[in]  Hy        grid_ptr to the Hy field
+     * @param[in]  Hz        grid_ptr to the Hz field
+     */
+    parallelTFSFFloat(std::shared_ptr<mpiInterface> gridComm, std::array<int,3> locO, std::array<int,3> sz, double theta, double phi, double psi, POLARIZATION circPol, double kLenRelJ, double dx, double dt,  std::vector<std::shared_ptr<PulseBase>> pul, float_pgrid_ptr Ex, float_pgrid_ptr Ey, float_pgrid_ptr Ez, float_pgrid_ptr Hx, float_pgrid_ptr Hy, float_pgrid_ptr Hz);
+};
 
 #endif
\ No newline at end of file
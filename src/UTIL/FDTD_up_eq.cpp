@@ -27,6 +27,67 @@ void FDTDCompUpdateFxnReal::TwoCompCurl (std::array<int,8>& axParams, std::array
     return;
 }
 
+void FDTDCompUpdateFxnReal::OneCompCurlJFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    double* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const double* jm = &grid_j->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const double* jp = &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]);
+    const double pref = prefactors[1];
+    // Finite difference of the j derivative components in the curl in one pass over the run
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * (jm[ii] - jp[ii]);
+    return;
+}
+
+void FDTDCompUpdateFxnReal::OneCompCurlKFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    double* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const double* km = &grid_k->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const double* kp = &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]);
+    const double pref = prefactors[1];
+    // Finite differnce of the k derivatives components in the curl in one pass over the run
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * (kp[ii] - km[ii]);
+    return;
+}
+
+void FDTDCompUpdateFxnReal::TwoCompCurlFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    double* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const double* jm = &grid_j->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const double* jp = &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]);
+    const double* km = &grid_k->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const double* kp = &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]);
+    const double pref = prefactors[1];
+    // Both the j and k finite differences are accumulated before the field is written back (prefactor is always real)
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * ( (jm[ii] - jp[ii]) + (kp[ii] - km[ii]) );
+    return;
+}
+
+void FDTDCompUpdateFxnReal::OneCompCurlJSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the j derivative components in the curl
+    curlSIMD::diff1(axParams[0], prefactors[1], &grid_i->point(axParams[1], axParams[2], axParams[3]), &grid_j->point(axParams[1], axParams[2], axParams[3]), &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]));
+    return;
+}
+
+void FDTDCompUpdateFxnReal::OneCompCurlKSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the k derivative components in the curl (kp - km is passed as the first difference)
+    curlSIMD::diff1(axParams[0], prefactors[1], &grid_i->point(axParams[1], axParams[2], axParams[3]), &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]), &grid_k->point(axParams[1], axParams[2], axParams[3]));
+    return;
+}
+
+void FDTDCompUpdateFxnReal::TwoCompCurlSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Both the j and k finite differences are accumulated before the field is written back
+    curlSIMD::diff2(axParams[0], prefactors[1], &grid_i->point(axParams[1], axParams[2], axParams[3]),
+        &grid_j->point(axParams[1], axParams[2], axParams[3]), &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]),
+        &grid_k->point(axParams[1], axParams[2], axParams[3]), &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]));
+    return;
+}
+
 void FDTDCompUpdateFxnCplx::OneCompCurlJ (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
 {
     // Finite difference of the j derivative components in the curl
@@ -54,6 +115,67 @@ void FDTDCompUpdateFxnCplx::TwoCompCurl (std::array<int,8>& axParams, std::array
     return;
 }
 
+void FDTDCompUpdateFxnCplx::OneCompCurlJFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    cplx* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const cplx* jm = &grid_j->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const cplx* jp = &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]);
+    const double pref = prefactors[1];
+    // Finite difference of the j derivative components in the curl in one pass over the run
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * (jm[ii] - jp[ii]);
+    return;
+}
+
+void FDTDCompUpdateFxnCplx::OneCompCurlKFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    cplx* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const cplx* km = &grid_k->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const cplx* kp = &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]);
+    const double pref = prefactors[1];
+    // Finite differnce of the k derivatives components in the curl in one pass over the run
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * (kp[ii] - km[ii]);
+    return;
+}
+
+void FDTDCompUpdateFxnCplx::TwoCompCurlFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    cplx* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const cplx* jm = &grid_j->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const cplx* jp = &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]);
+    const cplx* km = &grid_k->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const cplx* kp = &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]);
+    const double pref = prefactors[1];
+    // Both the j and k finite differences are accumulated before the field is written back (prefactor is always real)
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * ( (jm[ii] - jp[ii]) + (kp[ii] - km[ii]) );
+    return;
+}
+
+void FDTDCompUpdateFxnCplx::OneCompCurlJSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the j derivative components in the curl (the real and imaginary parts are treated as one array of doubles since the prefactor is real)
+    curlSIMD::diff1(2*axParams[0], prefactors[1], reinterpret_cast<double*>(&grid_i->point(axParams[1], axParams[2], axParams[3])), reinterpret_cast<const double*>(&grid_j->point(axParams[1], axParams[2], axParams[3])), reinterpret_cast<const double*>(&grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5])));
+    return;
+}
+
+void FDTDCompUpdateFxnCplx::OneCompCurlKSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the k derivative components in the curl (kp - km is passed as the first difference) (the real and imaginary parts are treated as one array of doubles since the prefactor is real)
+    curlSIMD::diff1(2*axParams[0], prefactors[1], reinterpret_cast<double*>(&grid_i->point(axParams[1], axParams[2], axParams[3])), reinterpret_cast<const double*>(&grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6])), reinterpret_cast<const double*>(&grid_k->point(axParams[1], axParams[2], axParams[3])));
+    return;
+}
+
+void FDTDCompUpdateFxnCplx::TwoCompCurlSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Both the j and k finite differences are accumulated before the field is written back (the real and imaginary parts are treated as one array of doubles since the prefactor is real)
+    curlSIMD::diff2(2*axParams[0], prefactors[1], reinterpret_cast<double*>(&grid_i->point(axParams[1], axParams[2], axParams[3])),
+        reinterpret_cast<const double*>(&grid_j->point(axParams[1], axParams[2], axParams[3])), reinterpret_cast<const double*>(&grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5])),
+        reinterpret_cast<const double*>(&grid_k->point(axParams[1], axParams[2], axParams[3])), reinterpret_cast<const double*>(&grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6])));
+    return;
+}
+
 void FDTDCompUpdateFxnReal::UpdateLorPol(std::array<int,8>& axParams, pgrid_ptr grid_i, std::vector<pgrid_ptr> & lorPi, std::vector<pgrid_ptr> & prevLorPi, double* jstore, std::shared_ptr<Obj> obj)
 {
     for(int pp = 0; pp < obj->alpha().size(); ++pp)
@@ -444,4 +566,260 @@ void FDTDCompUpdateFxnCplx::applyPBC1Proc(pgrid_ptr fUp, std::array<double,3> &
     //         }
     //     }
     // }
-}
\ No newline at end of file
+}
+
+void FDTDCompUpdateFxnFloat::OneCompCurlJ (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the j derivative components in the curl
+    saxpy_(axParams[0],      prefactors[1], &grid_j->point(axParams[1]            ,axParams[2]            ,axParams[3]            ), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    saxpy_(axParams[0], -1.0*prefactors[1], &grid_j->point(axParams[1]+axParams[6],axParams[2]+axParams[4],axParams[3]+axParams[5]), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::OneCompCurlK (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite differnce of the k derivatives components in the curl
+    saxpy_(axParams[0], -1.0*prefactors[1], &grid_k->point(axParams[1]            ,axParams[2]            ,axParams[3]            ), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    saxpy_(axParams[0],      prefactors[1], &grid_k->point(axParams[1]+axParams[4],axParams[2]+axParams[5],axParams[3]+axParams[6]), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::TwoCompCurl (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the j derivative components in the curl
+    saxpy_(axParams[0],      prefactors[1], &grid_j->point(axParams[1]            ,axParams[2]            ,axParams[3]            ), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    saxpy_(axParams[0], -1.0*prefactors[1], &grid_j->point(axParams[1]+axParams[6],axParams[2]+axParams[4],axParams[3]+axParams[5]), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    // Finite difference of the k derivative components in the curl
+    saxpy_(axParams[0], -1.0*prefactors[1], &grid_k->point(axParams[1]            ,axParams[2]            ,axParams[3]            ), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    saxpy_(axParams[0],      prefactors[1], &grid_k->point(axParams[1]+axParams[4],axParams[2]+axParams[5],axParams[3]+axParams[6]), 1, &grid_i->point(axParams[1],axParams[2],axParams[3]), 1);
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::OneCompCurlJFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    float* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const float* jm = &grid_j->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const float* jp = &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]);
+    const float pref = prefactors[1];
+    // Finite difference of the j derivative components in the curl in one pass over the run
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * (jm[ii] - jp[ii]);
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::OneCompCurlKFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    float* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const float* km = &grid_k->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const float* kp = &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]);
+    const float pref = prefactors[1];
+    // Finite differnce of the k derivatives components in the curl in one pass over the run
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * (kp[ii] - km[ii]);
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::TwoCompCurlFused (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    float* fi = &grid_i->point(axParams[1], axParams[2], axParams[3]);
+    const float* jm = &grid_j->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const float* jp = &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]);
+    const float* km = &grid_k->point(axParams[1]            , axParams[2]            , axParams[3]            );
+    const float* kp = &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]);
+    const float pref = prefactors[1];
+    // Both the j and k finite differences are accumulated before the field is written back (prefactor is always real and stored in single precision)
+    for(int ii = 0; ii < axParams[0]; ++ii)
+        fi[ii] += pref * ( (jm[ii] - jp[ii]) + (kp[ii] - km[ii]) );
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::OneCompCurlJSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the j derivative components in the curl
+    curlSIMD::diff1(axParams[0], static_cast<float>(prefactors[1]), &grid_i->point(axParams[1], axParams[2], axParams[3]), &grid_j->point(axParams[1], axParams[2], axParams[3]), &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]));
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::OneCompCurlKSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Finite difference of the k derivative components in the curl (kp - km is passed as the first difference)
+    curlSIMD::diff1(axParams[0], static_cast<float>(prefactors[1]), &grid_i->point(axParams[1], axParams[2], axParams[3]), &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]), &grid_k->point(axParams[1], axParams[2], axParams[3]));
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::TwoCompCurlSIMD (std::array<int,8>& axParams, std::array<double,2>& prefactors, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+{
+    // Both the j and k finite differences are accumulated before the field is written back
+    curlSIMD::diff2(axParams[0], static_cast<float>(prefactors[1]), &grid_i->point(axParams[1], axParams[2], axParams[3]),
+        &grid_j->point(axParams[1], axParams[2], axParams[3]), &grid_j->point(axParams[1]+axParams[6], axParams[2]+axParams[4], axParams[3]+axParams[5]),
+        &grid_k->point(axParams[1], axParams[2], axParams[3]), &grid_k->point(axParams[1]+axParams[4], axParams[2]+axParams[5], axParams[3]+axParams[6]));
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::UpdateLorPol(std::array<int,8>& axParams, pgrid_ptr grid_i, std::vector<pgrid_ptr> & lorPi, std::vector<pgrid_ptr> & prevLorPi, float* jstore, std::shared_ptr<Obj> obj)
+{
+    for(int pp = 0; pp < obj->alpha().size(); ++pp)
+    {
+        // Store current values of the Lorentzian polarizations into jstore
+        scopy_(axParams[0], &lorPi[pp]->point(axParams[1], axParams[2], axParams[3]),  1, jstore, 1);
+
+        // Update the polarizations as done in Taflove Ch. 7
+        sscal_(axParams[0], obj->alpha()[pp],     &lorPi[pp]->point(axParams[1], axParams[2], axParams[3]),  1);
+        saxpy_(axParams[0], obj->   xi()[pp], &prevLorPi[pp]->point(axParams[1], axParams[2], axParams[3]),  1, &lorPi[pp] ->point(axParams[1], axParams[2], axParams[3]), 1);
+        saxpy_(axParams[0], obj->gamma()[pp],        &grid_i->point(axParams[1], axParams[2], axParams[3]),  1, &lorPi[pp] ->point(axParams[1], axParams[2], axParams[3]), 1);
+        // reset prevLorP with the previously stored values in jstore
+        scopy_(axParams[0], jstore,1, &prevLorPi[pp]->point(axParams[1], axParams[2], axParams[3]), 1);
+    }
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::UpdateLorMag(std::array<int,8>& axParams, pgrid_ptr grid_i, std::vector<pgrid_ptr> & lorMi, std::vector<pgrid_ptr> & prevLorMi, float* jstore, std::shared_ptr<Obj> obj)
+{
+    for(int mm = 0; mm < obj->magAlpha().size(); ++mm)
+    {
+        // Store current values of the Lorentzian polarizations into jstore
+        scopy_(axParams[0], &lorMi[mm]->point(axParams[1], axParams[2], axParams[3]),  1, jstore, 1);
+
+        // Update the polarizations as done in Taflove Ch. 7
+        sscal_(axParams[0], obj->magAlpha()[mm],     &lorMi[mm]->point(axParams[1], axParams[2], axParams[3]),  1);
+        saxpy_(axParams[0], obj->   magXi()[mm], &prevLorMi[mm]->point(axParams[1], axParams[2], axParams[3]),  1, &lorMi[mm] ->point(axParams[1], axParams[2], axParams[3]), 1);
+        saxpy_(axParams[0], obj->magGamma()[mm],        &grid_i->point(axParams[1], axParams[2], axParams[3]),  1, &lorMi[mm] ->point(axParams[1], axParams[2], axParams[3]), 1);
+        // reset prevLorP with the previously stored values in jstore
+        scopy_(axParams[0], jstore,1, &prevLorMi[mm]->point(axParams[1], axParams[2], axParams[3]), 1);
+    }
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::DtoE(std::array<int,8>& axParams, pgrid_ptr Di, pgrid_ptr Ei, std::vector<pgrid_ptr> & lorPi, std::shared_ptr<Obj> obj)
+{
+    double eps = obj->epsInfty();
+    // Set the E field to the D field
+    scopy_(axParams[0], &Di->point(axParams[1],axParams[2], axParams[3]), 1,&Ei->point(axParams[1],axParams[2], axParams[3]), 1);
+    // Scale E field by 1/eps (Done because E = 1/eps D)
+    sscal_(axParams[0], 1.0/eps, &Ei->point(axParams[1],axParams[2], axParams[3]), 1);
+    // Add all Polarizations
+    for(int pp = 0; pp < obj->alpha().size(); ++pp)
+        saxpy_(axParams[0], -1.0/eps, &lorPi[pp]->point(axParams[1],axParams[2], axParams[3]), 1,&Ei->point(axParams[1],axParams[2], axParams[3]), 1);
+    return;
+
+}
+
+void FDTDCompUpdateFxnFloat::BtoH(std::array<int,8>& axParams, pgrid_ptr Bi, pgrid_ptr Hi, std::vector<pgrid_ptr> & lorMi, std::shared_ptr<Obj> obj)
+{
+    double mu = obj->muInfty();
+    // Set the E field to the D field
+    scopy_(axParams[0], &Bi->point(axParams[1],axParams[2], axParams[3]), 1, &Hi->point(axParams[1],axParams[2], axParams[3]), 1);
+    // Scale E field by 1/eps (Done because E = 1/eps D)
+    sscal_(axParams[0], 1.0/mu, &Hi->point(axParams[1],axParams[2], axParams[3]), 1);
+    // Add all Polarizations
+    for(int mm = 0; mm < obj->magAlpha().size(); ++mm)
+        saxpy_(axParams[0], -1.0/mu, &lorMi[mm]->point(axParams[1],axParams[2], axParams[3]), 1,&Hi->point(axParams[1],axParams[2], axParams[3]), 1);
+    return;
+}
+
+void FDTDCompUpdateFxnFloat::applyPBC(pgrid_ptr fUp, std::array<double,3> & k_point, int nx, int ny, int nz, int xmax, int ymax, int zmin, int zmax, double & dx, double & dy, double & dz)
+{
+    // if float fields then the PBC is just copying from one side to the other
+    if(zmin != 0)
+    {
+        for(int jj = 1; jj < ny; ++jj)
+        {
+            scopy_(nz-1, &fUp->point(xmax-1, jj, 1     ), fUp->local_x(), &fUp->point(0   , jj,      1), fUp->local_x() );
+            scopy_(nz-1, &fUp->point(1     , jj, 1     ), fUp->local_x(), &fUp->point(xmax, jj,      1), fUp->local_x() );
+
+            scopy_(nx-1, &fUp->point(1     , jj, zmax-1), 1             , &fUp->point(1   , jj, zmin-1), 1 );
+            scopy_(nx-1, &fUp->point(1     , jj, zmin  ), 1             , &fUp->point(1   , jj, zmax  ), 1 );
+        }
+
+        // // X edges
+        scopy_(nx-1, &fUp->point(1,      1, zmin  ), 1, &fUp->point(1, ymax  , zmax  ), 1);
+        scopy_(nx-1, &fUp->point(1, ymax-1, zmin  ), 1, &fUp->point(1, 0     , zmax  ), 1);
+        scopy_(nx-1, &fUp->point(1,      1, zmax-1), 1, &fUp->point(1, ymax  , zmin-1), 1);
+        scopy_(nx-1, &fUp->point(1, ymax-1, zmax-1), 1, &fUp->point(1, 0     , zmin-1), 1);
+
+        // Y edges
+        scopy_(ny-1, &fUp->point(     1, 1, zmin  ), fUp->local_x()*fUp->local_z(), &fUp->point(xmax  , 1, zmax  ), fUp->local_x()*fUp->local_z());
+        scopy_(ny-1, &fUp->point(xmax-1, 1, zmin  ), fUp->local_x()*fUp->local_z(), &fUp->point(0     , 1, zmax  ), fUp->local_x()*fUp->local_z());
+        scopy_(ny-1, &fUp->point(     1, 1, zmax-1), fUp->local_x()*fUp->local_z(), &fUp->point(xmax  , 1, zmin-1), fUp->local_x()*fUp->local_z());
+        scopy_(ny-1, &fUp->point(xmax-1, 1, zmax-1), fUp->local_x()*fUp->local_z(), &fUp->point(0     , 1, zmin-1), fUp->local_x()*fUp->local_z());
+
+        // Z edges
+        scopy_(nz-1, &fUp->point(1     , 1     , 1), fUp->local_x(), &fUp->point(xmax, ymax, 1), fUp->local_x());
+        scopy_(nz-1, &fUp->point(xmax-1, 1     , 1), fUp->local_x(), &fUp->point(0   , ymax, 1), fUp->local_x());
+        scopy_(nz-1, &fUp->point(1     , ymax-1, 1), fUp->local_x(), &fUp->point(xmax, 0   , 1), fUp->local_x());
+        scopy_(nz-1, &fUp->point(xmax-1, ymax-1, 1), fUp->local_x(), &fUp->point(0   , 0   , 1), fUp->local_x());
+
+        // //Corners
+        fUp->point(xmax, ymax, zmax  ) = fUp->point(1     , 1     , zmin  );
+        fUp->point(0   , ymax, zmax  ) = fUp->point(xmax-1, 1     , zmin  );
+        fUp->point(xmax, 0   , zmax  ) = fUp->point(1     , ymax-1, zmin  );
+        fUp->point(0   , 0   , zmax  ) = fUp->point(xmax-1, ymax-1, zmin  );
+
+        fUp->point(xmax, ymax, zmin-1) = fUp->point(1     , 1     , zmax-1);
+        fUp->point(0   , ymax, zmin-1) = fUp->point(xmax-1, 1     , zmax-1);
+        fUp->point(xmax, 0   , zmin-1) = fUp->point(1     , ymax-1, zmax-1);
+        fUp->point(0   , 0   , zmin-1) = fUp->point(xmax-1, ymax-1, zmax-1);
+    }
+    else
+    {
+        scopy_(fUp->local_y(), &fUp->point(xmax-1, 0), fUp->local_x(), &fUp->point(0   , 0), fUp->local_x() );
+        scopy_(fUp->local_y(), &fUp->point(1     , 0), fUp->local_x(), &fUp->point(xmax, 0), fUp->local_x() );
+    }
+}
+
+void FDTDCompUpdateFxnFloat::applyPBC1Proc(pgrid_ptr fUp, std::array<double,3> & k_point, int nx, int ny, int nz, int xmax, int ymax, int zmin, int zmax, double & dx, double & dy, double & dz)
+{
+    // if float fields then the PBC is just copying from one side to the other
+    if(zmin != 0)
+    {
+        for(int kk = zmin; kk < nz; ++kk)
+        {
+            scopy_(nx-1, &fUp->point(1   , ymax-1, kk),  1, &fUp->point(1 , 0   , kk), 1 );
+            scopy_(nx-1, &fUp->point(1   , 1     , kk),  1, &fUp->point(1 , ymax, kk), 1 );
+        }
+        for(int jj = 1; jj < ny; ++jj)
+        {
+            scopy_(nz-1, &fUp->point(xmax-1, jj, 1), fUp->local_x(), &fUp->point(0   , jj, 1), fUp->local_x() );
+            scopy_(nz-1, &fUp->point(1     , jj, 1), fUp->local_x(), &fUp->point(xmax, jj, 1), fUp->local_x() );
+
+            scopy_(nx-1, &fUp->point(1, jj, zmax-1), 1, &fUp->point(1, jj, zmin-1), 1 );
+            scopy_(nx-1, &fUp->point(1, jj, zmin  ), 1, &fUp->point(1, jj, zmax  ), 1 );
+        }
+
+        // X edges
+        scopy_(nx-1, &fUp->point(1,      1, zmin  ), 1, &fUp->point(1, ymax  , zmax  ), 1);
+        scopy_(nx-1, &fUp->point(1, ymax-1, zmin  ), 1, &fUp->point(1, 0     , zmax  ), 1);
+        scopy_(nx-1, &fUp->point(1,      1, zmax-1), 1, &fUp->point(1, ymax  , zmin-1), 1);
+        scopy_(nx-1, &fUp->point(1, ymax-1, zmax-1), 1, &fUp->point(1, 0     , zmin-1), 1);
+
+        // Y edges
+        scopy_(ny-1, &fUp->point(     1, 1, zmin  ), fUp->local_x()*fUp->local_z(), &fUp->point(xmax  , 1, zmax  ), fUp->local_x()*fUp->local_z());
+        scopy_(ny-1, &fUp->point(xmax-1, 1, zmin  ), fUp->local_x()*fUp->local_z(), &fUp->point(0     , 1, zmax  ), fUp->local_x()*fUp->local_z());
+        scopy_(ny-1, &fUp->point(     1, 1, zmax-1), fUp->local_x()*fUp->local_z(), &fUp->point(xmax  , 1, zmin-1), fUp->local_x()*fUp->local_z());
+        scopy_(ny-1, &fUp->point(xmax-1, 1, zmax-1), fUp->local_x()*fUp->local_z(), &fUp->point(0     , 1, zmin-1), fUp->local_x()*fUp->local_z());
+
+        // Z edges
+        scopy_(nz-1, &fUp->point(1     , 1     , 1), fUp->local_x(), &fUp->point(xmax, ymax, 1), fUp->local_x());
+        scopy_(nz-1, &fUp->point(xmax-1, 1     , 1), fUp->local_x(), &fUp->point(0   , ymax, 1), fUp->local_x());
+        scopy_(nz-1, &fUp->point(1     , ymax-1, 1), fUp->local_x(), &fUp->point(xmax, 0   , 1), fUp->local_x());
+        scopy_(nz-1, &fUp->point(xmax-1, ymax-1, 1), fUp->local_x(), &fUp->point(0   , 0   , 1), fUp->local_x());
+
+        //Corners
+        fUp->point(xmax, ymax, zmax  ) = fUp->point(1     , 1     , zmin  );
+        fUp->point(0   , ymax, zmax  ) = fUp->point(xmax-1, 1     , zmin  );
+        fUp->point(xmax, 0   , zmax  ) = fUp->point(1     , ymax-1, zmin  );
+        fUp->point(0   , 0   , zmax  ) = fUp->point(xmax-1, ymax-1, zmin  );
+
+        fUp->point(xmax, ymax, zmin-1) = fUp->point(1     , 1     , zmax-1);
+        fUp->point(0   , ymax, zmin-1) = fUp->point(xmax-1, 1     , zmax-1);
+        fUp->point(xmax, 0   , zmin-1) = fUp->point(1     , ymax-1, zmax-1);
+        fUp->point(0   , 0   , zmin-1) = fUp->point(xmax-1, ymax-1, zmax-1);
+    }
+    else
+    {
+        scopy_(nx-1, &fUp->point(1     , ymax-1),  1            , &fUp->point(1   , 0   ),              1 );
+        scopy_(nx-1, &fUp->point(1     , 1     ),  1            , &fUp->point(1   , ymax),              1 );
+        scopy_(ny-1, &fUp->point(xmax-1, 1     ), fUp->local_x(), &fUp->point(0   , 1   ), fUp->local_x() );
+        scopy_(ny-1, &fUp->point(1     , 1     ), fUp->local_x(), &fUp->point(xmax, 1   ), fUp->local_x() );
+    }
+}
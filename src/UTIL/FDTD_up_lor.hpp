@@ -0,0 +1,232 @@
+#ifndef PARALLEL_FDTD_UPLOR
+#define PARALLEL_FDTD_UPLOR
+
+#include <OBJECTS/Obj.hpp>
+#include <UTIL/typedefs.hpp>
+#include <algorithm>
+
+/**
+ * @brief      The Lorentz pole fields of one field component stored interleaved per cell, with a kernel that updates all poles and converts D to E (or B to H) in one pass
+ * @details    The values of every pole of a cell are stored next to each other and the cells follow the runs of the D (or B) update list, so the poles of a run are one contiguous block and only cells in dispersive objects take up space. For every cell the kernel reads E, D and the poles once and writes E and the poles once, instead of the five blas passes per pole of the polarization update and the two passes plus one per pole of the D to E conversion.
+ *
+ * The poles of an object are stored by type: the Lorentz poles as (P, Pprev), then the Debye poles as P (xi = 0 so the previous value is not needed), then the Drude poles as the current J = P^{n+1} - P^n (J^n = -xi J^{n-1} + gamma E^n). The sum of the Drude polarizations is folded into D, so a Drude cell stores D - P_Drude and E = (D - P_Drude - sum of the other poles)/eps_infty. The folding is only done if the polarization fields are not output, otherwise the Drude poles are stored as Lorentz poles.
+ */
+template <typename T> class lorentzPoleStore
+{
+protected:
+    typedef std::shared_ptr<parallelGrid<T>> pgrid_ptr;
+    typedef decltype(std::real(std::declval<T>())) coef_type; //!< the pole constants are stored with the precision of the fields (float for float fields, double otherwise)
+
+    std::vector<T> vals_; //!< the pole values of every cell in the update list
+    std::vector<int> start_; //!< index in vals_ of the first value of each run
+    std::vector<int> nLor_; //!< number of Lorentz poles of each object
+    std::vector<int> nDeb_; //!< number of Debye poles of each object
+    std::vector<int> nDru_; //!< number of Drude poles of each object that are folded into D
+    std::vector<int> cellSz_; //!< number of stored values per cell of each object
+    std::vector<int> poleStart_; //!< index in poleIdx_ of the first pole of each object
+    std::vector<int> poleIdx_; //!< index of each pole in the object's material in storage order
+    std::vector<int> coefStart_; //!< index in coefs_ of the constants of the first pole of each object
+    std::vector<coef_type> coefs_; //!< alpha, xi, and gamma of every Lorentz pole, alpha and gamma of every Debye pole, and -xi and gamma of every Drude pole of every object
+    std::vector<coef_type> invInfty_; //!< 1/eps_infty (or 1/mu_infty) of each object
+
+public:
+    /**
+     * @brief      Sets up the storage for an update list, all poles start at zero
+     *
+     * @param[in]  up         The D (or B) update list, its order must not change afterwards
+     * @param[in]  objArr     The object array (setUpConsts must have been called)
+     * @param[in]  mag        True if the poles are magnetization poles
+     * @param[in]  foldDrude  True if the Drude polarizations are folded into D (or B)
+     */
+    lorentzPoleStore(const upLists& up, const std::vector<std::shared_ptr<Obj>>& objArr, bool mag, bool foldDrude)
+    {
+        for(auto& obj : objArr)
+        {
+            const std::vector<double>& alpha = mag ? obj->magAlpha() : obj->alpha();
+            const std::vector<double>& xi    = mag ? obj->magXi()    : obj->xi();
+            const std::vector<double>& gamma = mag ? obj->magGamma() : obj->gamma();
+            const std::vector<POLETYPE>& type = mag ? obj->magPoleType() : obj->poleType();
+            std::array<std::vector<int>,3> byType;
+            for(int pp = 0; pp < alpha.size(); ++pp)
+            {
+                if(type[pp] == POLETYPE::DEBYE)
+                    byType[1].push_back(pp);
+                else if(type[pp] == POLETYPE::DRUDE && foldDrude)
+                    byType[2].push_back(pp);
+                else
+                    byType[0].push_back(pp);
+            }
+            nLor_.push_back(byType[0].size() );
+            nDeb_.push_back(byType[1].size() );
+            nDru_.push_back(byType[2].size() );
+            cellSz_.push_back(2*nLor_.back() + nDeb_.back() + nDru_.back() );
+            poleStart_.push_back(poleIdx_.size() );
+            coefStart_.push_back(coefs_.size() );
+            for(int pp : byType[0])
+            {
+                coefs_.push_back(alpha[pp]);
+                coefs_.push_back(xi[pp]);
+                coefs_.push_back(gamma[pp]);
+            }
+            for(int pp : byType[1])
+            {
+                coefs_.push_back(alpha[pp]);
+                coefs_.push_back(gamma[pp]);
+            }
+            for(int pp : byType[2])
+            {
+                coefs_.push_back(-1.0*xi[pp]);
+                coefs_.push_back(gamma[pp]);
+            }
+            for(auto& idx : byType)
+                poleIdx_.insert(poleIdx_.end(), idx.begin(), idx.end() );
+            invInfty_.push_back(1.0 / (mag ? obj->muInfty() : obj->epsInfty() ) );
+        }
+        int nVals = 0;
+        for(auto& run : up)
+        {
+            start_.push_back(nVals);
+            nVals += cellSz_[std::get<0>(run)[7]] * std::get<0>(run)[0];
+        }
+        vals_.resize(nVals, 0.0);
+    }
+
+    /**
+     * @brief      Updates the poles of a run and sets E = (D - sum of the poles) / eps_infty in a single pass
+     *
+     * @param[in]  rr    The index of the run in the update list
+     * @param[in]  ax    The axParams of the run
+     * @param      Di    The D (or B) field, the Drude polarizations are subtracted from it
+     * @param      Ei    The E (or H) field, drives the poles with its value from the previous step and is overwritten
+     */
+    void update(int rr, const std::array<int,8>& ax, pgrid_ptr Di, pgrid_ptr Ei)
+    {
+        const int nL = nLor_[ax[7]];
+        const int nB = nDeb_[ax[7]];
+        const int nD = nDru_[ax[7]];
+        const int sz = cellSz_[ax[7]];
+        const coef_type* cfL = coefs_.data() + coefStart_[ax[7]];
+        const coef_type* cfB = cfL + 3*nL;
+        const coef_type* cfD = cfB + 2*nB;
+        const coef_type inv = invInfty_[ax[7]];
+        const coef_type mInv = -inv;
+        T* p = vals_.data() + start_[rr];
+        T* ei = &Ei->point(ax[1], ax[2], ax[3]);
+        T* di = &Di->point(ax[1], ax[2], ax[3]);
+        // Same operation order as the blas updates for the Lorentz poles so both give the same fields
+        for(int ii = 0; ii < ax[0]; ++ii, p += sz)
+        {
+            const T e = ei[ii];
+            T d = di[ii];
+            if(nD > 0)
+            {
+                T* pD = p + 2*nL + nB;
+                for(int pp = 0; pp < nD; ++pp)
+                {
+                    pD[pp] = cfD[2*pp] * pD[pp] + cfD[2*pp+1] * e;
+                    d -= pD[pp];
+                }
+                di[ii] = d;
+            }
+            T eNew = d * inv;
+            for(int pp = 0; pp < nL; ++pp)
+            {
+                const T cur = p[2*pp];
+                const T next = (cfL[3*pp] * cur + cfL[3*pp+1] * p[2*pp+1]) + cfL[3*pp+2] * e;
+                p[2*pp+1] = cur;
+                p[2*pp] = next;
+                eNew += mInv * next;
+            }
+            T* pB = p + 2*nL;
+            for(int pp = 0; pp < nB; ++pp)
+            {
+                pB[pp] = cfB[2*pp] * pB[pp] + cfB[2*pp+1] * e;
+                eNew += mInv * pB[pp];
+            }
+            ei[ii] = eNew;
+        }
+    }
+
+    /**
+     * @brief      Copies the poles into one grid per pole (points outside the update list are not touched)
+     * @details    Lorentz poles fill both grids, Debye poles only the current grid, and Drude poles folded into D put their current J in the current grid
+     *
+     * @param[in]  up       The update list the store was made with
+     * @param      lor      The grids for the current pole values
+     * @param      prevLor  The grids for the pole values at the previous time step
+     */
+    void toGrids(const upLists& up, std::vector<pgrid_ptr>& lor, std::vector<pgrid_ptr>& prevLor) const
+    {
+        for(int rr = 0; rr < up.size(); ++rr)
+        {
+            const std::array<int,8>& ax = std::get<0>(up[rr]);
+            const int sz = cellSz_[ax[7]];
+            const int* idx = poleIdx_.data() + poleStart_[ax[7]];
+            int off = 0;
+            for(int pp = 0; pp < nLor_[ax[7]] + nDeb_[ax[7]] + nDru_[ax[7]]; ++pp)
+            {
+                const bool hasPrev = pp < nLor_[ax[7]];
+                T* cur = &lor[idx[pp]]->point(ax[1], ax[2], ax[3]);
+                T* prev = &prevLor[idx[pp]]->point(ax[1], ax[2], ax[3]);
+                const T* p = vals_.data() + start_[rr] + off;
+                for(int ii = 0; ii < ax[0]; ++ii)
+                {
+                    cur[ii] = p[sz*ii];
+                    if(hasPrev)
+                        prev[ii] = p[sz*ii+1];
+                }
+                off += hasPrev ? 2 : 1;
+            }
+        }
+    }
+
+    /**
+     * @brief      Copies the poles from one grid per pole (same layout as toGrids)
+     *
+     * @param[in]  up       The update list the store was made with
+     * @param[in]  lor      The grids with the current pole values
+     * @param[in]  prevLor  The grids with the pole values at the previous time step
+     */
+    void fromGrids(const upLists& up, const std::vector<pgrid_ptr>& lor, const std::vector<pgrid_ptr>& prevLor)
+    {
+        for(int rr = 0; rr < up.size(); ++rr)
+        {
+            const std::array<int,8>& ax = std::get<0>(up[rr]);
+            const int sz = cellSz_[ax[7]];
+            const int* idx = poleIdx_.data() + poleStart_[ax[7]];
+            int off = 0;
+            for(int pp = 0; pp < nLor_[ax[7]] + nDeb_[ax[7]] + nDru_[ax[7]]; ++pp)
+            {
+                const bool hasPrev = pp < nLor_[ax[7]];
+                const T* cur = &lor[idx[pp]]->point(ax[1], ax[2], ax[3]);
+                const T* prev = &prevLor[idx[pp]]->point(ax[1], ax[2], ax[3]);
+                T* p = vals_.data() + start_[rr] + off;
+                for(int ii = 0; ii < ax[0]; ++ii)
+                {
+                    p[sz*ii] = cur[ii];
+                    if(hasPrev)
+                        p[sz*ii+1] = prev[ii];
+                }
+                off += hasPrev ? 2 : 1;
+            }
+        }
+    }
+
+    /**
+     * @return     The largest number of poles of any object
+     */
+    inline int maxPoles() const
+    {
+        int np = 0;
+        for(int oo = 0; oo < nLor_.size(); ++oo)
+            np = std::max(np, nLor_[oo] + nDeb_[oo] + nDru_[oo]);
+        return np;
+    }
+
+    /**
+     * @return     The number of stored values
+     */
+    inline int size() const {return vals_.size();}
+};
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef PARALLEL_FDTD_UPPLAN
+#define PARALLEL_FDTD_UPPLAN
+
+#include <UTIL/typedefs.hpp>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+
+/**
+ * @brief      A curl update list compiled into flat arrays that are run by a templated kernel
+ * @details    Each run is stored as the flat index of its first point, its length, and the index of its curl prefactor in a table of the distinct prefactors. The offsets to the second point of each finite difference are the same for every run in an update list so they are only stored once. Which terms of the curl are used is decided once per call, so there is no function dispatch per run.
+ * Runs that touch each other in memory can be merged into one run with a per-cell index into the prefactor table, so rows cut up by material boundaries are updated in a single sweep.
+ */
+template <typename T> class curlUpdatePlan
+{
+protected:
+    typedef std::shared_ptr<parallelGrid<T>> pgrid_ptr;
+    typedef decltype(std::real(std::declval<T>())) coef_type; //!< the prefactors are stored with the precision of the fields (float for float fields, double otherwise)
+
+    std::vector<int> start_; //!< flat index of the first point of each run in the updated field
+    std::vector<int> len_; //!< number of points in each run
+    std::vector<int> coefInd_; //!< index of the curl prefactor of each run in coefs_, -1 if the prefactor changes inside the run
+    std::vector<int> cellOff_; //!< index of the first point of each run in cellCoef_ (only used for runs with coefInd_ of -1)
+    std::vector<std::uint16_t> cellCoef_; //!< index of the curl prefactor in coefs_ for every point of the runs whose prefactor changes
+    std::vector<coef_type> coefs_; //!< the distinct curl prefactors of the update list
+    std::vector<int> listToPlan_; //!< the plan run that starts at each update list element, only valid at the thread bounds the plan was made with
+
+    int rowOff_; //!< flat index of the first stored point of the updated field in the j and k fields (nonzero if its rows are restricted, see parallelGrid::restrictRows)
+    int jOff_; //!< flat offset of the second point of the j finite difference
+    int kOff_; //!< flat offset of the second point of the k finite difference
+    bool useJ_; //!< True if the j field is part of the curl
+    bool useK_; //!< True if the k field is part of the curl
+
+    /**
+     * @brief      Updates runs first to last-1 with the curl terms selected at compile time
+     *
+     * @param[in]  first  The first run
+     * @param[in]  last   One past the last run
+     * @param      fi     Pointer to the start of the field being updated
+     * @param[in]  fj     Pointer to the start of the j field
+     * @param[in]  fk     Pointer to the start of the k field
+     *
+     * @tparam     J      True if the j field is part of the curl
+     * @tparam     K      True if the k field is part of the curl
+     */
+    template <bool J, bool K> void runKernel(int first, int last, T* fi, const T* fj, const T* fk)
+    {
+        for(int rr = first; rr < last; ++rr)
+        {
+            T* fiRun = fi + start_[rr];
+            const T* jm = fj + rowOff_ + start_[rr];
+            const T* jp = jm + jOff_;
+            const T* km = fk + rowOff_ + start_[rr];
+            const T* kp = km + kOff_;
+            if(coefInd_[rr] >= 0)
+            {
+                const coef_type pref = coefs_[coefInd_[rr]];
+                for(int ii = 0; ii < len_[rr]; ++ii)
+                {
+                    T curl = 0.0;
+                    if(J)
+                        curl += jm[ii] - jp[ii];
+                    if(K)
+                        curl += kp[ii] - km[ii];
+                    fiRun[ii] += pref * curl;
+                }
+            }
+            else
+            {
+                // Merged run: the prefactor of each point is looked up in the small table of distinct prefactors
+                const coef_type* coefs = coefs_.data();
+                const std::uint16_t* cc = cellCoef_.data() + cellOff_[rr];
+                for(int ii = 0; ii < len_[rr]; ++ii)
+                {
+                    T curl = 0.0;
+                    if(J)
+                        curl += jm[ii] - jp[ii];
+                    if(K)
+                        curl += kp[ii] - km[ii];
+                    fiRun[ii] += coefs[cc[ii]] * curl;
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief      Constructs an empty plan
+     */
+    curlUpdatePlan() :
+        listToPlan_(1, 0),
+        rowOff_(0),
+        jOff_(0),
+        kOff_(0),
+        useJ_(false),
+        useK_(false)
+    {}
+
+    /**
+     * @brief      Compiles an update list into a plan
+     *
+     * @param[in]  up         The update list
+     * @param[in]  bounds     The thread bounds that will be used with the plan, runs are never merged across them
+     * @param[in]  mergeRuns  If true merge runs that touch in memory and use per-cell prefactors where the prefactor changes
+     * @param[in]  grid_i     The field being updated
+     * @param[in]  grid_j     The jth field with ijk notation (nullptr if it is not part of the curl)
+     * @param[in]  grid_k     The kth field with ijk notation (nullptr if it is not part of the curl)
+     */
+    curlUpdatePlan(const upLists& up, const std::vector<int>& bounds, bool mergeRuns, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k) :
+        listToPlan_(up.size()+1, 0),
+        rowOff_(grid_i ? grid_i->rowOffset() : 0),
+        jOff_(0),
+        kOff_(0),
+        useJ_(grid_j != nullptr),
+        useK_(grid_k != nullptr)
+    {
+        if( (grid_j && grid_j->rowOffset() != 0) || (grid_k && grid_k->rowOffset() != 0) )
+            throw std::logic_error("The curl fields of a curlUpdatePlan can not have restricted rows");
+        std::map<double, int> coefMap;
+        int bb = 0;
+        for(int rr = 0; rr < up.size(); ++rr)
+        {
+            const std::array<int,8>& ax = std::get<0>(up[rr]);
+            const T* base = &grid_i->point(ax[1], ax[2], ax[3]);
+            int jOff = &grid_i->point(ax[1]+ax[6], ax[2]+ax[4], ax[3]+ax[5]) - base;
+            int kOff = &grid_i->point(ax[1]+ax[4], ax[2]+ax[5], ax[3]+ax[6]) - base;
+            if(rr == 0)
+            {
+                jOff_ = jOff;
+                kOff_ = kOff;
+            }
+            else if(jOff != jOff_ || kOff != kOff_)
+            {
+                throw std::logic_error("All runs in a curlUpdatePlan need the same derivative offsets");
+            }
+            auto coef = coefMap.insert(std::make_pair(std::get<1>(up[rr])[1], static_cast<int>(coefs_.size() ) ) );
+            if(coef.second)
+                coefs_.push_back(std::get<1>(up[rr])[1]);
+            if(coefs_.size() > UINT16_MAX)
+                throw std::logic_error("Too many distinct curl prefactors for the per-cell prefactor indexes of a curlUpdatePlan");
+
+            // A new run starts at every thread bound and wherever the list run does not continue the last one in memory
+            while(bb < bounds.size() && bounds[bb] < rr)
+                ++bb;
+            int start = base - grid_i->data();
+            bool newRun = !mergeRuns || start_.size() == 0 || (bb < bounds.size() && bounds[bb] == rr) || start != start_.back() + len_.back();
+            if(newRun)
+            {
+                start_.push_back(start);
+                len_.push_back(ax[0]);
+                coefInd_.push_back(coef.first->second);
+                cellOff_.push_back(0);
+            }
+            else
+            {
+                // Switch the run to per-cell prefactors the first time the prefactor changes inside it
+                if(coefInd_.back() >= 0 && coefInd_.back() != coef.first->second)
+                {
+                    cellOff_.back() = cellCoef_.size();
+                    cellCoef_.insert(cellCoef_.end(), len_.back(), static_cast<std::uint16_t>(coefInd_.back() ) );
+                    coefInd_.back() = -1;
+                }
+                if(coefInd_.back() < 0)
+                    cellCoef_.insert(cellCoef_.end(), ax[0], static_cast<std::uint16_t>(coef.first->second) );
+                len_.back() += ax[0];
+            }
+            listToPlan_[rr] = newRun ? start_.size()-1 : start_.size();
+        }
+        listToPlan_[up.size()] = start_.size();
+    }
+
+    /**
+     * @brief      Updates the runs made from the update list elements first to last-1
+     *
+     * @param[in]  first   The first update list element (must be one of the thread bounds the plan was made with)
+     * @param[in]  last    One past the last update list element (must be one of the thread bounds the plan was made with)
+     * @param[in]  grid_i  The field being updated
+     * @param[in]  grid_j  The jth field with ijk notation
+     * @param[in]  grid_k  The kth field with ijk notation
+     */
+    void update(int first, int last, pgrid_ptr grid_i, pgrid_ptr grid_j, pgrid_ptr grid_k)
+    {
+        // Fields that are not in the calculation have empty plans and no grids
+        if(first >= last)
+            return;
+        first = listToPlan_[first];
+        last  = listToPlan_[last];
+        // The field being updated stands in for the missing field since the kernel never reads it
+        if(useJ_ && useK_)
+            runKernel<true , true >(first, last, grid_i->data(), grid_j->data(), grid_k->data() );
+        else if(useJ_)
+            runKernel<true , false>(first, last, grid_i->data(), grid_j->data(), grid_i->data() );
+        else if(useK_)
+            runKernel<false, true >(first, last, grid_i->data(), grid_i->data(), grid_k->data() );
+    }
+
+    /**
+     * @return     The number of runs in the plan
+     */
+    inline int nRuns() {return start_.size();}
+
+    /**
+     * @return     The number of distinct curl prefactors in the plan
+     */
+    inline int nCoefs() {return coefs_.size();}
+
+    /**
+     * @brief      Counts the runs of an update list by length
+     *
+     * @param[in]  up     The update list
+     * @param[in]  nBins  The number of bins
+     *
+     * @return     The number of runs with lengths in [2^bb, 2^(bb+1)) for each bin bb, the last bin holds all longer runs
+     */
+    static std::vector<int> runLengthHist(const upLists& up, int nBins)
+    {
+        std::vector<int> hist(nBins, 0);
+        for(auto& run : up)
+        {
+            int bb = 0;
+            for(int len = std::get<0>(run)[0]; len > 1 && bb < nBins-1; len /= 2)
+                ++bb;
+            ++hist[bb];
+        }
+        return hist;
+    }
+};
+
+#endif
@@ -0,0 +1,215 @@
+#include <UTIL/FDTD_up_simd.hpp>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define FDTD_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    typedef void (*diff1D)(int, double, double*, const double*, const double*);
+    typedef void (*diff2D)(int, double, double*, const double*, const double*, const double*, const double*);
+    typedef void (*diff1F)(int, float, float*, const float*, const float*);
+    typedef void (*diff2F)(int, float, float*, const float*, const float*, const float*, const float*);
+
+    /**
+     * @brief      The kernels for one instruction set
+     */
+    struct kernelTable
+    {
+        SIMDISA isa_; //!< the instruction set of the kernels
+        diff1D diff1D_; //!< double precision one finite difference kernel
+        diff2D diff2D_; //!< double precision two finite difference kernel
+        diff1F diff1F_; //!< single precision one finite difference kernel
+        diff2F diff2F_; //!< single precision two finite difference kernel
+    };
+
+    template <typename T> void diff1Scalar(int n, T pref, T* fi, const T* am, const T* ap)
+    {
+        for(int ii = 0; ii < n; ++ii)
+            fi[ii] += pref * (am[ii] - ap[ii]);
+    }
+
+    template <typename T> void diff2Scalar(int n, T pref, T* fi, const T* am, const T* ap, const T* bm, const T* bp)
+    {
+        for(int ii = 0; ii < n; ++ii)
+            fi[ii] += pref * ( (am[ii] - ap[ii]) + (bp[ii] - bm[ii]) );
+    }
+
+#ifdef FDTD_SIMD_X86
+    // The target attributes let these functions use AVX2/AVX-512 without compiling the rest of the code for them, the CPU is checked before they are ever called
+    __attribute__((target("avx2,fma"))) void diff1AVX2(int n, double pref, double* fi, const double* am, const double* ap)
+    {
+        const __m256d p = _mm256_set1_pd(pref);
+        int ii = 0;
+        for(; ii + 4 <= n; ii += 4)
+        {
+            __m256d d = _mm256_sub_pd(_mm256_loadu_pd(am+ii), _mm256_loadu_pd(ap+ii) );
+            _mm256_storeu_pd(fi+ii, _mm256_fmadd_pd(p, d, _mm256_loadu_pd(fi+ii) ) );
+        }
+        for(; ii < n; ++ii)
+            fi[ii] += pref * (am[ii] - ap[ii]);
+    }
+
+    __attribute__((target("avx2,fma"))) void diff2AVX2(int n, double pref, double* fi, const double* am, const double* ap, const double* bm, const double* bp)
+    {
+        const __m256d p = _mm256_set1_pd(pref);
+        int ii = 0;
+        for(; ii + 4 <= n; ii += 4)
+        {
+            __m256d d = _mm256_add_pd(_mm256_sub_pd(_mm256_loadu_pd(am+ii), _mm256_loadu_pd(ap+ii) ), _mm256_sub_pd(_mm256_loadu_pd(bp+ii), _mm256_loadu_pd(bm+ii) ) );
+            _mm256_storeu_pd(fi+ii, _mm256_fmadd_pd(p, d, _mm256_loadu_pd(fi+ii) ) );
+        }
+        for(; ii < n; ++ii)
+            fi[ii] += pref * ( (am[ii] - ap[ii]) + (bp[ii] - bm[ii]) );
+    }
+
+    __attribute__((target("avx2,fma"))) void diff1AVX2(int n, float pref, float* fi, const float* am, const float* ap)
+    {
+        const __m256 p = _mm256_set1_ps(pref);
+        int ii = 0;
+        for(; ii + 8 <= n; ii += 8)
+        {
+            __m256 d = _mm256_sub_ps(_mm256_loadu_ps(am+ii), _mm256_loadu_ps(ap+ii) );
+            _mm256_storeu_ps(fi+ii, _mm256_fmadd_ps(p, d, _mm256_loadu_ps(fi+ii) ) );
+        }
+        for(; ii < n; ++ii)
+            fi[ii] += pref * (am[ii] - ap[ii]);
+    }
+
+    __attribute__((target("avx2,fma"))) void diff2AVX2(int n, float pref, float* fi, const float* am, const float* ap, const float* bm, const float* bp)
+    {
+        const __m256 p = _mm256_set1_ps(pref);
+        int ii = 0;
+        for(; ii + 8 <= n; ii += 8)
+        {
+            __m256 d = _mm256_add_ps(_mm256_sub_ps(_mm256_loadu_ps(am+ii), _mm256_loadu_ps(ap+ii) ), _mm256_sub_ps(_mm256_loadu_ps(bp+ii), _mm256_loadu_ps(bm+ii) ) );
+            _mm256_storeu_ps(fi+ii, _mm256_fmadd_ps(p, d, _mm256_loadu_ps(fi+ii) ) );
+        }
+        for(; ii < n; ++ii)
+            fi[ii] += pref * ( (am[ii] - ap[ii]) + (bp[ii] - bm[ii]) );
+    }
+
+    // The AVX-512 kernels finish each run with one masked operation instead of a scalar loop
+    __attribute__((target("avx512f"))) void diff1AVX512(int n, double pref, double* fi, const double* am, const double* ap)
+    {
+        const __m512d p = _mm512_set1_pd(pref);
+        int ii = 0;
+        for(; ii + 8 <= n; ii += 8)
+        {
+            __m512d d = _mm512_sub_pd(_mm512_loadu_pd(am+ii), _mm512_loadu_pd(ap+ii) );
+            _mm512_storeu_pd(fi+ii, _mm512_fmadd_pd(p, d, _mm512_loadu_pd(fi+ii) ) );
+        }
+        if(ii < n)
+        {
+            const __mmask8 m = static_cast<__mmask8>( (1u << (n - ii) ) - 1u);
+            __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(m, am+ii), _mm512_maskz_loadu_pd(m, ap+ii) );
+            _mm512_mask_storeu_pd(fi+ii, m, _mm512_fmadd_pd(p, d, _mm512_maskz_loadu_pd(m, fi+ii) ) );
+        }
+    }
+
+    __attribute__((target("avx512f"))) void diff2AVX512(int n, double pref, double* fi, const double* am, const double* ap, const double* bm, const double* bp)
+    {
+        const __m512d p = _mm512_set1_pd(pref);
+        int ii = 0;
+        for(; ii + 8 <= n; ii += 8)
+        {
+            __m512d d = _mm512_add_pd(_mm512_sub_pd(_mm512_loadu_pd(am+ii), _mm512_loadu_pd(ap+ii) ), _mm512_sub_pd(_mm512_loadu_pd(bp+ii), _mm512_loadu_pd(bm+ii) ) );
+            _mm512_storeu_pd(fi+ii, _mm512_fmadd_pd(p, d, _mm512_loadu_pd(fi+ii) ) );
+        }
+        if(ii < n)
+        {
+            const __mmask8 m = static_cast<__mmask8>( (1u << (n - ii) ) - 1u);
+            __m512d d = _mm512_add_pd(_mm512_sub_pd(_mm512_maskz_loadu_pd(m, am+ii), _mm512_maskz_loadu_pd(m, ap+ii) ), _mm512_sub_pd(_mm512_maskz_loadu_pd(m, bp+ii), _mm512_maskz_loadu_pd(m, bm+ii) ) );
+            _mm512_mask_storeu_pd(fi+ii, m, _mm512_fmadd_pd(p, d, _mm512_maskz_loadu_pd(m, fi+ii) ) );
+        }
+    }
+
+    __attribute__((target("avx512f"))) void diff1AVX512(int n, float pref, float* fi, const float* am, const float* ap)
+    {
+        const __m512 p = _mm512_set1_ps(pref);
+        int ii = 0;
+        for(; ii + 16 <= n; ii += 16)
+        {
+            __m512 d = _mm512_sub_ps(_mm512_loadu_ps(am+ii), _mm512_loadu_ps(ap+ii) );
+            _mm512_storeu_ps(fi+ii, _mm512_fmadd_ps(p, d, _mm512_loadu_ps(fi+ii) ) );
+        }
+        if(ii < n)
+        {
+            const __mmask16 m = static_cast<__mmask16>( (1u << (n - ii) ) - 1u);
+            __m512 d = _mm512_sub_ps(_mm512_maskz_loadu_ps(m, am+ii), _mm512_maskz_loadu_ps(m, ap+ii) );
+            _mm512_mask_storeu_ps(fi+ii, m, _mm512_fmadd_ps(p, d, _mm512_maskz_loadu_ps(m, fi+ii) ) );
+        }
+    }
+
+    __attribute__((target("avx512f"))) void diff2AVX512(int n, float pref, float* fi, const float* am, const float* ap, const float* bm, const float* bp)
+    {
+        const __m512 p = _mm512_set1_ps(pref);
+        int ii = 0;
+        for(; ii + 16 <= n; ii += 16)
+        {
+            __m512 d = _mm512_add_ps(_mm512_sub_ps(_mm512_loadu_ps(am+ii), _mm512_loadu_ps(ap+ii) ), _mm512_sub_ps(_mm512_loadu_ps(bp+ii), _mm512_loadu_ps(bm+ii) ) );
+            _mm512_storeu_ps(fi+ii, _mm512_fmadd_ps(p, d, _mm512_loadu_ps(fi+ii) ) );
+        }
+        if(ii < n)
+        {
+            const __mmask16 m = static_cast<__mmask16>( (1u << (n - ii) ) - 1u);
+            __m512 d = _mm512_add_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(m, am+ii), _mm512_maskz_loadu_ps(m, ap+ii) ), _mm512_sub_ps(_mm512_maskz_loadu_ps(m, bp+ii), _mm512_maskz_loadu_ps(m, bm+ii) ) );
+            _mm512_mask_storeu_ps(fi+ii, m, _mm512_fmadd_ps(p, d, _mm512_maskz_loadu_ps(m, fi+ii) ) );
+        }
+    }
+#endif
+
+    /**
+     * @brief      Finds the widest instruction set supported by the CPU and returns its kernels
+     *
+     * @return     The kernel table
+     */
+    kernelTable makeTable()
+    {
+#ifdef FDTD_SIMD_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") )
+            return kernelTable{SIMDISA::AVX512, diff1AVX512, diff2AVX512, diff1AVX512, diff2AVX512};
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+            return kernelTable{SIMDISA::AVX2, diff1AVX2, diff2AVX2, diff1AVX2, diff2AVX2};
+#endif
+        return kernelTable{SIMDISA::SCALAR, diff1Scalar<double>, diff2Scalar<double>, diff1Scalar<float>, diff2Scalar<float>};
+    }
+
+    const kernelTable kernels_ = makeTable(); //!< The kernels used for the curl updates
+}
+
+SIMDISA curlSIMD::isa()
+{
+    return kernels_.isa_;
+}
+
+std::string curlSIMD::isaName(SIMDISA s)
+{
+    if(s == SIMDISA::AVX512)
+        return "AVX-512";
+    else if(s == SIMDISA::AVX2)
+        return "AVX2";
+    return "scalar";
+}
+
+void curlSIMD::diff1(int n, double pref, double* fi, const double* am, const double* ap)
+{
+    kernels_.diff1D_(n, pref, fi, am, ap);
+}
+
+void curlSIMD::diff2(int n, double pref, double* fi, const double* am, const double* ap, const double* bm, const double* bp)
+{
+    kernels_.diff2D_(n, pref, fi, am, ap, bm, bp);
+}
+
+void curlSIMD::diff1(int n, float pref, float* fi, const float* am, const float* ap)
+{
+    kernels_.diff1F_(n, pref, fi, am, ap);
+}
+
+void curlSIMD::diff2(int n, float pref, float* fi, const float* am, const float* ap, const float* bm, const float* bp)
+{
+    kernels_.diff2F_(n, pref, fi, am, ap, bm, bp);
+}
@@ -0,0 +1,62 @@
+#ifndef PARALLEL_FDTD_UPSIMD
+#define PARALLEL_FDTD_UPSIMD
+
+#include <UTIL/enum.hpp>
+#include <string>
+
+/**
+ * @brief      Hand vectorized kernels for the curl update of one run
+ * @details    The curl prefactors are always real, so a complex field is updated as an array of twice as many doubles where the real and imaginary parts get the same prefactor instead of with complex multiplies. The instruction set (AVX-512, AVX2 with FMA, or plain loops) is picked once at run time from what the CPU supports, so the speed of the updates does not depend on the linked BLAS.
+ */
+namespace curlSIMD
+{
+    /**
+     * @return     The instruction set used by the kernels
+     */
+    SIMDISA isa();
+
+    /**
+     * @brief      Converts a SIMDISA to a string
+     *
+     * @param[in]  s     The instruction set
+     *
+     * @return     The name of the instruction set
+     */
+    std::string isaName(SIMDISA s);
+
+    /**
+     * @brief      Adds one finite difference to a run: fi += pref * (am - ap)
+     *
+     * @param[in]  n     The number of points in the run
+     * @param[in]  pref  The curl prefactor
+     * @param      fi    Pointer to the first point of the field being updated
+     * @param[in]  am    Pointer to the first point added by the finite difference
+     * @param[in]  ap    Pointer to the first point subtracted by the finite difference
+     */
+    void diff1(int n, double pref, double* fi, const double* am, const double* ap);
+
+    /**
+     * @brief      Adds two finite differences to a run: fi += pref * ( (am - ap) + (bp - bm) )
+     *
+     * @param[in]  n     The number of points in the run
+     * @param[in]  pref  The curl prefactor
+     * @param      fi    Pointer to the first point of the field being updated
+     * @param[in]  am    Pointer to the first point added by the first finite difference
+     * @param[in]  ap    Pointer to the first point subtracted by the first finite difference
+     * @param[in]  bm    Pointer to the first point subtracted by the second finite difference
+     * @param[in]  bp    Pointer to the first point added by the second finite difference
+     */
+    void diff2(int n, double pref, double* fi, const double* am, const double* ap, const double* bm, const double* bp);
+
+    /**
+     * @brief      Single precision version of diff1
+     */
+    void diff1(int n, float pref, float* fi, const float* am, const float* ap);
+
+    /**
+     * @brief      Single precision version of diff2
+     */
+    void diff2(int n, float pref, float* fi, const float* am, const float* ap, const float* bm, const float* bp);
+}
+
+#endif
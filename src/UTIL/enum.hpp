@@ -10,6 +10,9 @@
     enum class DTCTYPE{EX, EY, EZ, HX, HY, HZ, EPOW, HPOW, PX, PY, PZ, MX, MY, MZ};
     enum class DTCCLASS{COUT, TXT, BIN, BMP, FREQ};
     enum class DTCCLASSTYPE{FIELD, POW, POL};
-    enum class PROC_DIR {UP, DOWN, LEFT, RIGHT, NONE };
+    enum class PROC_DIR {UP, DOWN, LEFT, RIGHT, FRONT, BACK, NONE };
     enum class DISTRIBUTION {GAUSSIAN, DELTAFXN, SKEW_NORMAL, CHI_SQUARED};
+    enum class CURLKERNEL {BLAS, FUSED, PLAN, CELL, SIMD};
+    enum class SIMDISA {SCALAR, AVX2, AVX512};
+    enum class POLETYPE {LORENTZ, DRUDE, DEBYE};
 #endif
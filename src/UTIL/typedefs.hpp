@@ -9,9 +9,11 @@ typedef std::complex<double> cplx;
 
 typedef std::shared_ptr<Grid<cplx>> cplx_grid_ptr;
 typedef std::shared_ptr<Grid<double>> real_grid_ptr;
+typedef std::shared_ptr<Grid<float>> float_grid_ptr;
 typedef std::shared_ptr<Grid<int>> int_grid_ptr;
 
 typedef std::shared_ptr<parallelGrid<cplx>> cplx_pgrid_ptr;
 typedef std::shared_ptr<parallelGrid<double>> real_pgrid_ptr;
+typedef std::shared_ptr<parallelGrid<float>> float_pgrid_ptr;
 typedef std::shared_ptr<parallelGrid<int>> int_pgrid_ptr;
 #endif
\ No newline at end of file
@@ -24,11 +24,11 @@ extern "C"
 
     double ddot_(const int*, const double*, const int*, const double*, const int*);
 
-    void saxpy_(const int*, const int*, const int*, const int*, int*, const int*);
+    void saxpy_(const int*, const float*, const float*, const int*, float*, const int*);
 
-    void scopy_(const int*, const int*, const int*, int*, const int*);
+    void scopy_(const int*, const float*, const int*, float*, const int*);
 
-    void sscal_(const int*, const int*, int*, const int*);
+    void sscal_(const int*, const float*, float*, const int*);
 
     void daxpy_(const int*, const double*, const double*, const int*, double*, const int*);
 
@@ -279,7 +279,7 @@ namespace
      * @param      y     Array, size at least (1 + (n-1)*abs(incy)).
      * @param[in]  incy  INTEGER. Specifies the increment for the elements of y.
      */
-    void saxpy_(const int n, const int a, const int* x, const int incx, int* y, const int incy) { ::saxpy_(&n,&a,x,&incx,y,&incy); }
+    void saxpy_(const int n, const float a, const float* x, const int incx, float* y, const int incy) { ::saxpy_(&n,&a,x,&incx,y,&incy); }
 
     /**
      * @brief      wrapper for scopy_
@@ -290,7 +290,7 @@ namespace
      * @param      y     Array, size at least (1 + (n-1)*abs(incy)).
      * @param[in]  incy  INTEGER. Specifies the increment for the elements of y.
      */
-    void scopy_(const int n, const int* x, const int incx, int* y, const int incy) { ::scopy_(&n,x,&incx,y,&incy);}
+    void scopy_(const int n, const float* x, const int incx, float* y, const int incy) { ::scopy_(&n,x,&incx,y,&incy);}
 
    /**
      * @brief      wrapper for saxpy_
@@ -300,7 +300,7 @@ namespace
      * @param[in]  x     Array, size at least (1 + (n-1)*abs(incx)).
      * @param[in]  incx  INTEGER. Specifies the increment for the elements of x
      */
-    void sscal_(const int n, const int a, int* x, const int incx) {::sscal_(&n,&a,x,&incx);}
+    void sscal_(const int n, const float a, float* x, const int incx) {::sscal_(&n,&a,x,&incx);}
 
    /**
      * @brief      wrapper for saxpy_
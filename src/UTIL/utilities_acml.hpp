@@ -267,8 +267,8 @@ namespace
      * @param      y     Array, size at least (1 + (n-1)*abs(incy)).
      * @param[in]  incy  INTEGER. Specifies the increment for the elements of y.
      */
-    void saxpy_(int n, int a, int* x, int incx, int* y, int incy)
-        { ::saxpy(n,a,reinterpret_cast<float*>(x),incx,reinterpret_cast<float*>(y),incy); }
+    void saxpy_(int n, float a, float* x, int incx, float* y, int incy)
+        { ::saxpy(n,a,x,incx,y,incy); }
 
     /**
      * @brief      wrapper for scopy_
@@ -279,8 +279,8 @@ namespace
      * @param      y     Array, size at least (1 + (n-1)*abs(incy)).
      * @param[in]  incy  INTEGER. Specifies the increment for the elements of y.
      */
-    void scopy_(int n, int* x, int incx, int* y, int incy)
-        { ::scopy(n,reinterpret_cast<float*>(x),incx,reinterpret_cast<float*>(y),incy);}
+    void scopy_(int n, float* x, int incx, float* y, int incy)
+        { ::scopy(n,x,incx,y,incy);}
 
    /**
      * @brief      wrapper for saxpy_
@@ -290,8 +290,8 @@ namespace
      * @param[in]  x     Array, size at least (1 + (n-1)*abs(incx)).
      * @param[in]  incx  INTEGER. Specifies the increment for the elements of x
      */
-    void sscal_(int n, int a, int* x, int incx)
-        {::sscal(n,a,reinterpret_cast<float*>(x),incx);}
+    void sscal_(int n, float a, float* x, int incx)
+        {::sscal(n,a,x,incx);}
 
    /**
      * @brief      wrapper for saxpy_
@@ -4,55 +4,51 @@
 // #include "FDTDFieldTM.hpp"
 
 #include <FDTD_MANAGER/parallelFDTDField.hpp>
+#include <MPI/parallelLoadBalancer.hpp>
 // #include <iomanip>
 
 namespace mpi = boost::mpi;
 
-int main(int argc, char const *argv[])
+/**
+ * @brief      Builds the propagator, runs the calculation, and outputs the flux and frequency detector results
+ * @details    If runtime load balancing is on the propagator is rebuilt with new y process boundaries whenever the measured time per step is too uneven, and the new propagator takes over the state of the old one.
+ *
+ * @param      IP        The input parameters
+ * @param[in]  gridComm  The MPI interface for the calculation
+ * @param[in]  start     The clock value at the start of the program
+ *
+ * @tparam     FIELD     The propagator type (double or single precision fields)
+ */
+template <typename FIELD> void runFDTD(parallelProgramInputs& IP, std::shared_ptr<mpiInterface> gridComm, std::clock_t start)
 {
-    // Initialize the boost mpi environment and communicator
-    mpi::environment env;
-    std::shared_ptr<mpiInterface> gridComm = std::make_shared<mpiInterface>();
-    std::clock_t start;
-    std::string filename;
     double duration= 0.0;
-    start = std::clock();
-    if (argc < 2)
-    {
-        std::cout << "Provide an input json file" << std::endl;
-        exit(1);
-    }
-    else
-    {
-        // Take in the file name and strip out all comments for the parser
-        filename = argv[1];
-        if(gridComm->rank() == 0)
-            stripComments(filename);
-        else
-            filename = "stripped_" + filename;
-    }
-    gridComm->barrier();
-    if(gridComm->rank() == 0)
-        std::cout << "Reading input file " << argv[1] << "..." << std::endl;
-    //construct the parser and pass it to the inputs
-    boost::property_tree::ptree propTree;
-    boost::property_tree::json_parser::read_json(filename,propTree);
-    parallelProgramInputs IP(propTree, filename);
-    gridComm->barrier();
-    if(gridComm->rank() == 0)
-         boost::filesystem::remove(filename) ;
-    if(gridComm->rank() == 0)
-        std::cout << "I TOOK ALL THE INPUT PARAMETERS" << std::endl;
-
-    double maxT = IP.tMax();
-
-    parallelFDTDFieldReal FF(IP, gridComm);
+    std::shared_ptr<FIELD> FF = std::make_shared<FIELD>(IP, gridComm);
     if(gridComm->rank() == 0)
         std::cout << "made" << std::endl;
 
+    parallelLoadBalancer balancer(gridComm, IP.rebalanceInterval_, IP.rebalanceThreshold_);
     int nSteps = int(std::ceil( IP.tMax_ / (IP.courant_/IP.res_) ) );
-    for(int tt = 0; tt < nSteps; ++tt )
-        FF.step();
+    // Advance several steps at a time when temporal blocking is on (stepTile falls back to single steps otherwise)
+    for(int tt = 0; tt < nSteps; )
+    {
+        double wallStart = MPI_Wtime();
+        double waitStart = FF->commWaitTime();
+        int nAdvanced = FF->stepTile(nSteps - tt);
+        tt += nAdvanced;
+        if(!balancer.on() )
+            continue;
+        balancer.addSteps(nAdvanced, MPI_Wtime() - wallStart, FF->commWaitTime() - waitStart);
+        if(balancer.check(FF->procLoc()[1], FF->localSize()[1]) )
+        {
+            // The old propagator's files have to be closed before the new detectors open them to append
+            FF->closeOutputs();
+            IP.resumeOutput_ = true;
+            std::shared_ptr<FIELD> newFF = std::make_shared<FIELD>(IP, gridComm);
+            newFF->migrateFrom(*FF);
+            FF = newFF;
+        }
+    }
+    FF->finishTransfers();
 
     duration = ( std::clock() - start ) / (double) CLOCKS_PER_SEC;
     for(int ii = 0; ii < gridComm->size(); ii ++)
@@ -62,19 +58,19 @@ int main(int argc, char const *argv[])
             std::cout << gridComm->rank() << "\t" << duration<<std::endl;
     }
     // Output the final flux for all flux objects, Polarization terms are because of units for continuous boxes defined by the z component (TE off grid is E fields, TM H fields)
-    for(auto & flux : FF.fluxArr() )
+    for(auto & flux : FF->fluxArr() )
     {
-        // flux->getFlux(FF.E_incd(), FF.H_incd(), FF.H_mn_incd());
-        if(FF.Ez_)
-            flux->getFlux(FF.E_incd(), FF.H_incd(), FF.H_mn_incd(), true);
+        // flux->getFlux(FF->E_incd(), FF->H_incd(), FF->H_mn_incd());
+        if(FF->Ez_)
+            flux->getFlux(FF->E_incd(), FF->H_incd(), FF->H_mn_incd(), true);
         else
-            flux->getFlux(FF.E_incd(), FF.H_incd(), FF.E_pl_incd(), false);
+            flux->getFlux(FF->E_incd(), FF->H_incd(), FF->E_pl_incd(), false);
     }
     // Power outputs need incident fields for normalization
-    for(auto & dtc : FF.dtcFreqArr())
+    for(auto & dtc : FF->dtcFreqArr())
     {
         if(dtc->pow())
-            dtc->toFile(FF.E_incd(), FF.dt());
+            dtc->toFile(FF->E_incd(), FF->dt());
         else
             dtc->toFile();
     }
@@ -86,6 +82,116 @@ int main(int argc, char const *argv[])
         if(gridComm->rank() == ii)
             std::cout << gridComm->rank() << "\t" << duration<<std::endl;
     }
+}
+
+/**
+ * @brief      Reads an input file and runs its calculation, must be called by all processes in gridComm
+ *
+ * @param[in]  inputFile  The input json file name (in the current directory)
+ * @param[in]  gridComm   The MPI interface for the calculation
+ * @param[in]  start      The clock value at the start of the program
+ */
+void runInput(const std::string& inputFile, std::shared_ptr<mpiInterface> gridComm, std::clock_t start)
+{
+    // Strip out all comments for the parser
+    std::string filename = inputFile;
+    if(gridComm->rank() == 0)
+        stripComments(filename);
+    else
+        filename = "stripped_" + filename;
+    gridComm->barrier();
+    if(gridComm->rank() == 0)
+        std::cout << "Reading input file " << inputFile << "..." << std::endl;
+    //construct the parser and pass it to the inputs
+    boost::property_tree::ptree propTree;
+    boost::property_tree::json_parser::read_json(filename,propTree);
+    parallelProgramInputs IP(propTree, filename);
+    // Group the processes by node so neighboring slabs exchange their borders inside the node, then lay them out in the requested Cartesian process grid
+    if(IP.reorderRanks_)
+        gridComm->reorderByNode();
+    gridComm->setProcGrid(IP.procGrid_);
+    // Time the update kernels on this machine so the cell is split by their measured costs
+    if(IP.calibrateCosts_)
+        IP.costModel_.calibrate(gridComm, IP.curlKernel_, IP.costProfile_);
+    // Group the processes by the node they share memory with for the shared memory halo exchanges
+    if(IP.sharedHalo_)
+        gridComm->setupNodeComm();
+    gridComm->barrier();
+    if(gridComm->rank() == 0)
+         boost::filesystem::remove(filename) ;
+    if(gridComm->rank() == 0)
+        std::cout << "I TOOK ALL THE INPUT PARAMETERS" << std::endl;
+
+    // Single precision fields halve the memory traffic of the updates
+    if(IP.singlePrec_)
+        runFDTD<parallelFDTDFieldFloat>(IP, gridComm, start);
+    else
+        runFDTD<parallelFDTDFieldReal>(IP, gridComm, start);
+}
+
+/**
+ * @brief      Runs many independent input files at once by splitting the processes into groups
+ * @details    The processes are split into min(number of inputs, number of processes) groups of consecutive ranks and the inputs are dealt out to the groups round robin. Each input runs in its own directory named after the input file (so all outputs of a case stay together), with a copy of the input file in it. The input files must have different names.
+ *
+ * @param[in]  inputFiles  The input json file names
+ * @param[in]  world       The communicator of all processes
+ * @param[in]  start       The clock value at the start of the program
+ */
+void runEnsemble(const std::vector<std::string>& inputFiles, const mpi::communicator& world, std::clock_t start)
+{
+    // Check all inputs before splitting up so a missing file stops every process instead of only one group
+    for(auto& fname : inputFiles)
+        if(!boost::filesystem::exists(fname) )
+            throw std::logic_error("The input file " + fname + " does not exist");
+    // Each case runs in a directory named after its input file, so two inputs with the same name would write over each other
+    std::vector<std::string> stems;
+    for(auto& fname : inputFiles)
+    {
+        std::string stem = boost::filesystem::path(fname).stem().string();
+        if(std::find(stems.begin(), stems.end(), stem) != stems.end() )
+            throw std::logic_error("More than one input file is named " + stem + ", the cases of an ensemble need different file names");
+        stems.push_back(stem);
+    }
+    int nGroups = std::min(static_cast<int>(inputFiles.size() ), world.size() );
+    int group = (world.rank() * nGroups) / world.size();
+    mpi::communicator groupComm = world.split(group);
+    if(world.rank() == 0)
+        std::cout << "Running " << inputFiles.size() << " inputs in " << nGroups << " groups of processes" << std::endl;
+
+    boost::filesystem::path runDir = boost::filesystem::current_path();
+    for(int cc = group; cc < inputFiles.size(); cc += nGroups)
+    {
+        boost::filesystem::path input = boost::filesystem::absolute(inputFiles[cc], runDir);
+        boost::filesystem::path caseDir = runDir / input.stem();
+        if(groupComm.rank() == 0)
+        {
+            boost::filesystem::create_directories(caseDir);
+            boost::filesystem::copy_file(input, caseDir / input.filename(), boost::filesystem::copy_options::overwrite_existing);
+        }
+        groupComm.barrier();
+        boost::filesystem::current_path(caseDir);
+        // Each case gets a fresh interface so the process grid and node layout of the last case are not reused
+        runInput(input.filename().string(), std::make_shared<mpiInterface>(groupComm), start);
+        boost::filesystem::current_path(runDir);
+    }
+    world.barrier();
+}
+
+int main(int argc, char const *argv[])
+{
+    // Initialize the boost mpi environment and communicator (the update threads make no MPI calls, but the optional progress thread does at times the main thread does not)
+    mpi::environment env(mpi::threading::serialized);
+    std::clock_t start = std::clock();
+    if (argc < 2)
+    {
+        std::cout << "Provide an input json file" << std::endl;
+        exit(1);
+    }
+    // More than one input file runs them all side by side on separate groups of processes
+    if(argc > 2)
+        runEnsemble(std::vector<std::string>(argv + 1, argv + argc), mpi::communicator(), start);
+    else
+        runInput(argv[1], std::make_shared<mpiInterface>(), start);
 
     return 0;
-}
\ No newline at end of file
+}